@@ -0,0 +1,53 @@
+#!/usr/bin/env bash
+# Starts a local dedicated server and NUM_BOTS headless bot clients against it.
+# The server records a CSV profile (frame time, net in/out and the ADSTut RPC counters) to
+# Saved/Profiling/CSV, one file per run, so runs at 8, 16, ... 128 bots can be compared.
+# Bandwidth is recorded per connection (PlayerN_OutBytesPerSecond/InBytesPerSecond) along with the
+# min and max across connections, not just as a server wide average.
+#
+# Usage: Scripts/BotLoadTest.sh <num bots> [seconds] [map]
+# Expects the ADSTutServer and ADSTut Linux binaries to be built into Binaries/Linux.
+#
+# FLOOD_BOTS=N turns the first N bots into flooders that send every server RPC each frame.
+# That soaks the RPC rate limiter: ServerRPCsDropped should climb while FrameTime and the
+# other bots' behaviour stay the same as a run without flooders.
+
+set -euo pipefail
+
+NUM_BOTS=${1:?usage: BotLoadTest.sh <num bots> [seconds] [map]}
+DURATION=${2:-120}
+MAP=${3:-/Game/FirstPersonCPP/Maps/FirstPersonExampleMap}
+
+PROJECT_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BIN_DIR=${BIN_DIR:-$PROJECT_DIR/Binaries/Linux}
+PORT=${PORT:-7777}
+FLOOD_BOTS=${FLOOD_BOTS:-0}
+
+# The dedicated server ticks at 30Hz by default, leave some slack for startup
+CAPTURE_FRAMES=$(( (DURATION + 10) * 30 ))
+
+PIDS=()
+cleanup() {
+	kill "${PIDS[@]}" 2>/dev/null || true
+	wait 2>/dev/null || true
+}
+trap cleanup EXIT
+
+"$BIN_DIR/ADSTutServer" "$MAP" -port="$PORT" -log="BotLoadTest_Server_${NUM_BOTS}.log" \
+	-csvCaptureFrames="$CAPTURE_FRAMES" -csvMetadata="Bots=$NUM_BOTS,FloodBots=$FLOOD_BOTS" -unattended &
+PIDS+=($!)
+
+# Give the server time to open the map before the clients connect
+sleep 10
+
+for (( Bot = 0; Bot < NUM_BOTS; ++Bot )); do
+	FLOOD_ARG=""
+	if (( Bot < FLOOD_BOTS )); then
+		FLOOD_ARG="-ADSBotFlood"
+	fi
+	"$BIN_DIR/ADSTut" "127.0.0.1:$PORT" -nullrhi -nosound -unattended -ADSBot -ADSBotSeed="$Bot" $FLOOD_ARG \
+		-log="BotLoadTest_Bot${Bot}.log" &
+	PIDS+=($!)
+done
+
+sleep "$DURATION"
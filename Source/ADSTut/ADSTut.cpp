@@ -4,4 +4,7 @@
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ADSTut, "ADSTut" );
- 
\ No newline at end of file
+
+DEFINE_LOG_CATEGORY(LogADSTutLoad);
+
+CSV_DEFINE_CATEGORY(ADSTut, true);
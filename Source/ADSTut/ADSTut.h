@@ -3,3 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/** Load and startup timings, on by default so headless runs report them */
+DECLARE_LOG_CATEGORY_EXTERN(LogADSTutLoad, Log, All);
+
+CSV_DECLARE_CATEGORY_EXTERN(ADSTut);
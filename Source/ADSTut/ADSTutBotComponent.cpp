@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTutBotComponent.h"
+#include "ADSTutCharacter.h"
+#include "ADSTutTimerSubsystem.h"
+
+#include "Misc/CommandLine.h"
+
+UADSTutBotComponent::UADSTutBotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	Character = nullptr;
+	ShotsLeftInBurst = 0;
+	bFlood = false;
+	MoveInput = FVector2D::ZeroVector;
+}
+
+bool UADSTutBotComponent::IsBotClient()
+{
+	static const bool bIsBotClient = FParse::Param(FCommandLine::Get(), TEXT("ADSBot"));
+	return bIsBotClient;
+}
+
+void UADSTutBotComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Character = Cast<AADSTutCharacter>(GetOwner());
+
+	// -ADSBotSeed=N makes a run repeatable, otherwise every bot gets its own pattern
+	int32 Seed = 0;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("ADSBotSeed="), Seed))
+	{
+		Seed = FPlatformProcess::GetCurrentProcessId();
+	}
+	Stream.Initialize(Seed);
+
+	bFlood = FParse::Param(FCommandLine::Get(), TEXT("ADSBotFlood"));
+
+	ScheduleNextAction(Stream.FRandRange(0.2f, 1.5f));
+}
+
+void UADSTutBotComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UADSTutTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UADSTutTimerSubsystem>())
+	{
+		TimerSubsystem->GetTimingWheel().Cancel(NextActionHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UADSTutBotComponent::ScheduleNextAction(float DelaySeconds)
+{
+	if (UADSTutTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UADSTutTimerSubsystem>())
+	{
+		NextActionHandle = TimerSubsystem->GetTimingWheel().Schedule(DelaySeconds,
+			FSimpleDelegate::CreateUObject(this, &UADSTutBotComponent::PerformNextAction));
+	}
+}
+
+void UADSTutBotComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Character || !Character->IsLocallyControlled())
+	{
+		return;
+	}
+
+	Character->MoveForward(MoveInput.X);
+	Character->MoveRight(MoveInput.Y);
+	Character->AddControllerYawInput(FMath::Sin(Character->GetGameTimeSinceCreation()) * 0.5f);
+
+	// Well over the server budget at any frame rate, both the event and the state RPCs
+	if (bFlood)
+	{
+		Character->OnFire();
+		Character->Reload();
+		Character->SetAiming(!Character->IsAimingDownSights());
+		Character->CycleOptic();
+	}
+}
+
+void UADSTutBotComponent::PerformNextAction()
+{
+	if (!Character || !Character->IsLocallyControlled())
+	{
+		ScheduleNextAction(1.0f);
+		return;
+	}
+
+	// Finish a burst before picking anything else, at roughly 600 rounds per minute
+	if (ShotsLeftInBurst > 0)
+	{
+		--ShotsLeftInBurst;
+		Character->OnFire();
+		ScheduleNextAction(0.1f);
+		return;
+	}
+
+	const float Roll = Stream.FRand();
+	if (Roll < 0.4f)
+	{
+		ShotsLeftInBurst = Stream.RandRange(3, 10);
+	}
+	else if (Roll < 0.65f)
+	{
+		Character->SetAiming(!Character->IsAimingDownSights());
+	}
+	else if (Roll < 0.75f)
+	{
+		Character->CycleOptic();
+	}
+	else if (Roll < 0.85f)
+	{
+		Character->Reload();
+	}
+	else
+	{
+		MoveInput = FVector2D(Stream.FRandRange(-1.0f, 1.0f), Stream.FRandRange(-1.0f, 1.0f));
+	}
+
+	ScheduleNextAction(Stream.FRandRange(0.2f, 1.5f));
+}
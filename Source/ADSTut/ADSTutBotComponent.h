@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ADSTutTimingWheel.h"
+#include "ADSTutBotComponent.generated.h"
+
+class AADSTutCharacter;
+
+/**
+ * Drives a locally controlled character with a scripted mix of movement, ADS, optic cycling,
+ * reloads and fire bursts. Added to the character when the client is started with -ADSBot,
+ * so headless clients can load test a server.
+ * With -ADSBotFlood the bot also sends every server RPC on every frame, to soak the RPC rate limiter.
+ */
+UCLASS()
+class UADSTutBotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UADSTutBotComponent();
+
+	/** True when this process was started as a load test bot */
+	static bool IsBotClient();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	void PerformNextAction();
+	void ScheduleNextAction(float DelaySeconds);
+
+	UPROPERTY()
+	AADSTutCharacter* Character;
+
+	/** Seeded per bot so a run can be repeated */
+	FRandomStream Stream;
+
+	FWheelTimerHandle NextActionHandle;
+	int32 ShotsLeftInBurst;
+
+	bool bFlood;
+
+	/** Direction the bot is currently walking in, changed every few actions */
+	FVector2D MoveInput;
+};
@@ -1,12 +1,23 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ADSTutCharacter.h"
+#include "ADSTut.h"
+#include "ADSTutBotComponent.h"
+#include "ADSTutLoadout.h"
 #include "ADSTutProjectile.h"
+#include "ADSTutTimerSubsystem.h"
 #include "IKAnimInstance.h"
 
+#include "Animation/AnimMontage.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Curves/CurveVector.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
 #include "GameFramework/InputSettings.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
@@ -47,6 +58,37 @@ AADSTutCharacter::AADSTutCharacter()
 
 	bIsAiming = false;
 	OpticIndex = 0;
+	bWeaponReady = false;
+	bReceivedWeaponReplayState = false;
+
+	// Adaptive net update frequency drops idle characters towards the minimum rate,
+	// combat activity forces them straight back up
+	NetUpdateFrequency = 60.0f;
+	MinNetUpdateFrequency = 5.0f;
+	CombatActivityWindow = 3.0f;
+	CombatNetPriorityScale = 2.0f;
+	LastCombatActivityTime = -BIG_NUMBER;
+
+	ServerRPCRate = 20.0f;
+	ServerRPCBurst = 10.0f;
+	ServerRPCFloodPolicy = ERPCFloodPolicy::Throttle;
+}
+
+void AADSTutCharacter::PreRegisterAllComponents()
+{
+	// Arms animation, sway, recoil and IK are purely cosmetic. Registering Mesh1P creates its anim
+	// instance, so the class has to go before that for the server never to construct one. The meshes
+	// stay so the gun sockets can still be queried for hit validation, but they never tick
+	if (IsRunningDedicatedServer())
+	{
+		Mesh1P->SetAnimInstanceClass(nullptr);
+		Mesh1P->PrimaryComponentTick.bStartWithTickEnabled = false;
+		Mesh1P->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		FP_Gun->PrimaryComponentTick.bStartWithTickEnabled = false;
+		FP_Gun->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+
+	Super::PreRegisterAllComponents();
 }
 
 void AADSTutCharacter::BeginPlay()
@@ -57,7 +99,79 @@ void AADSTutCharacter::BeginPlay()
 	//Attach gun mesh component to Skeleton, doing it here because the skeleton is not yet created in the constructor
 	FP_Gun->AttachToComponent(Mesh1P, FAttachmentTransformRules(EAttachmentRule::SnapToTarget, true), TEXT("S_HandR"));
 
+	// Null on a dedicated server, see PreRegisterAllComponents
 	TutAnimInstance = Cast<UIKAnimInstance>(GetMesh1P()->GetAnimInstance());
+
+	RequestLoadout();
+}
+
+void AADSTutCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UADSTutTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UADSTutTimerSubsystem>())
+	{
+		TimerSubsystem->GetTimingWheel().Cancel(ThrottledStateHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AADSTutCharacter::RequestLoadout()
+{
+	if (!LoadoutId.IsValid())
+	{
+		OnLoadoutLoaded();
+		return;
+	}
+
+	// Usually already in flight from the map load preload, this just joins it
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAsset(LoadoutId, UADSTutLoadout::GetBundlesToLoad(),
+		FStreamableDelegate::CreateUObject(this, &AADSTutCharacter::OnLoadoutLoaded));
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		OnLoadoutLoaded();
+	}
+}
+
+void AADSTutCharacter::OnLoadoutLoaded()
+{
+	if (bWeaponReady)
+	{
+		return;
+	}
+
+	if (const UADSTutLoadout* Loadout = UAssetManager::Get().GetPrimaryAssetObject<UADSTutLoadout>(LoadoutId))
+	{
+		if (USkeletalMesh* ArmsMesh = Loadout->ArmsMesh.Get())
+		{
+			Mesh1P->SetSkeletalMesh(ArmsMesh, false);
+		}
+		if (USkeletalMesh* GunMesh = Loadout->GunMesh.Get())
+		{
+			FP_Gun->SetSkeletalMesh(GunMesh, false);
+		}
+		for (int32 Index = 0; Index < Optics.Num() && Index < Loadout->OpticMeshes.Num(); ++Index)
+		{
+			if (UStaticMesh* OpticMesh = Loadout->OpticMeshes[Index].Get())
+			{
+				Optics[Index]->SetStaticMesh(OpticMesh);
+			}
+		}
+		if (UAnimMontage* LoadoutFireAnimation = Loadout->FireAnimation.Get())
+		{
+			FireAnimation = LoadoutFireAnimation;
+		}
+		if (UAnimMontage* LoadoutReloadAnimation = Loadout->ReloadAnimation.Get())
+		{
+			ReloadAnimation = LoadoutReloadAnimation;
+		}
+		if (TutAnimInstance && Loadout->SwayCurve.Get())
+		{
+			TutAnimInstance->VectorCurve = Loadout->SwayCurve.Get();
+		}
+	}
+
+	bWeaponReady = true;
+	OnWeaponReady.Broadcast();
 }
 
 void AADSTutCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
@@ -65,6 +179,13 @@ void AADSTutCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerIn
 	// set up gameplay key bindings
 	check(PlayerInputComponent);
 
+	// Headless load test clients drive the pawn from a script instead of input
+	if (UADSTutBotComponent::IsBotClient() && !FindComponentByClass<UADSTutBotComponent>())
+	{
+		UADSTutBotComponent* BotComponent = NewObject<UADSTutBotComponent>(this, TEXT("BotComponent"));
+		BotComponent->RegisterComponent();
+	}
+
 	// Bind jump events
 	PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &ACharacter::Jump);
 	PlayerInputComponent->BindAction("Jump", IE_Released, this, &ACharacter::StopJumping);
@@ -91,10 +212,104 @@ void AADSTutCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 
 	DOREPLIFETIME_CONDITION(AADSTutCharacter, bIsAiming, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AADSTutCharacter, OpticIndex, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AADSTutCharacter, WeaponReplayState, COND_ReplayOnly);
+}
+
+bool AADSTutCharacter::ShouldKickForServerRPC() const
+{
+	if (ServerRPCFloodPolicy != ERPCFloodPolicy::Kick
+		|| ServerRPCLimiter.WouldAllow(GetWorld()->GetRealTimeSeconds(), ServerRPCRate, ServerRPCBurst))
+	{
+		return false;
+	}
+
+	UE_LOG(LogFPChar, Warning, TEXT("%s exceeded its server RPC budget, kicking"), *GetName());
+	return true;
+}
+
+bool AADSTutCharacter::ChargeServerRPC()
+{
+	CSV_CUSTOM_STAT(ADSTut, ServerRPCs, 1, ECsvCustomStatOp::Accumulate);
+
+	if (ServerRPCLimiter.TryConsume(GetWorld()->GetRealTimeSeconds(), ServerRPCRate, ServerRPCBurst))
+	{
+		return true;
+	}
+
+	CSV_CUSTOM_STAT(ADSTut, ServerRPCsDropped, 1, ECsvCustomStatOp::Accumulate);
+
+	// Only log the start of a flood, not every dropped RPC
+	if (ServerRPCLimiter.DroppedCount == 1)
+	{
+		UE_LOG(LogFPChar, Warning, TEXT("%s exceeded its server RPC budget, throttling"), *GetName());
+	}
+	return false;
+}
+
+void AADSTutCharacter::ScheduleThrottledServerState()
+{
+	UADSTutTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UADSTutTimerSubsystem>();
+	if (TimerSubsystem && !TimerSubsystem->GetTimingWheel().IsScheduled(ThrottledStateHandle))
+	{
+		ThrottledStateHandle = TimerSubsystem->GetTimingWheel().Schedule(ServerRPCLimiter.GetSecondsUntilToken(ServerRPCRate),
+			FSimpleDelegate::CreateUObject(this, &AADSTutCharacter::ApplyThrottledServerState));
+	}
+}
+
+void AADSTutCharacter::ApplyThrottledServerState()
+{
+	if (!ServerRPCLimiter.TryConsume(GetWorld()->GetRealTimeSeconds(), ServerRPCRate, ServerRPCBurst))
+	{
+		ScheduleThrottledServerState();
+		return;
+	}
+
+	// One token covers all pending state, only the latest value of each matters
+	if (ThrottledAiming.IsSet())
+	{
+		SetAiming(ThrottledAiming.GetValue());
+		ThrottledAiming.Reset();
+	}
+
+	if (ThrottledOpticIndex.IsSet())
+	{
+		OpticIndex = ThrottledOpticIndex.GetValue();
+		ThrottledOpticIndex.Reset();
+		OnRep_OpticIndex();
+		NoteCombatActivity();
+	}
+}
+
+float AADSTutCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	// Distance and view direction to this viewer are already part of the pawn priority
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+
+	if (IsInCombat())
+	{
+		Priority *= CombatNetPriorityScale;
+	}
+	return Priority;
+}
+
+bool AADSTutCharacter::IsInCombat() const
+{
+	return GetWorld()->GetTimeSeconds() - LastCombatActivityTime < CombatActivityWindow;
+}
+
+void AADSTutCharacter::NoteCombatActivity()
+{
+	if (HasAuthority())
+	{
+		LastCombatActivityTime = GetWorld()->GetTimeSeconds();
+		ForceNetUpdate();
+	}
 }
 
 void AADSTutCharacter::SetAiming(bool IsAiming)
 {
+	NoteCombatActivity();
+
 	bIsAiming = IsAiming;
 	if (TutAnimInstance)
 	{
@@ -117,14 +332,56 @@ void AADSTutCharacter::OnRep_IsAiming()
 
 bool AADSTutCharacter::Server_SetAiming_Validate(bool IsAiming)
 {
-	return true;
+	return !ShouldKickForServerRPC();
 }
 
 void AADSTutCharacter::Server_SetAiming_Implementation(bool IsAiming)
 {
+	if (!ChargeServerRPC())
+	{
+		ThrottledAiming = IsAiming;
+		ScheduleThrottledServerState();
+		return;
+	}
+
+	// A newer value supersedes one still waiting for budget
+	ThrottledAiming.Reset();
 	SetAiming(IsAiming);
 }
 
+void AADSTutCharacter::OnRep_WeaponReplayState(const FWeaponReplayState& OldState)
+{
+	// OldState is zeroed on the first update, the counters only start meaning something after it
+	if (!bReceivedWeaponReplayState)
+	{
+		bReceivedWeaponReplayState = true;
+		return;
+	}
+
+	// Seeking restores the state from a checkpoint, don't replay every shot since the last one
+	UDemoNetDriver* DemoNetDriver = GetWorld()->GetDemoNetDriver();
+	if (DemoNetDriver && DemoNetDriver->IsFastForwarding())
+	{
+		return;
+	}
+
+	if (WeaponReplayState.FireCount != OldState.FireCount)
+	{
+		PlayFireEffects();
+
+		// Recoil is normally kicked by the owning client's input, which a replay doesn't have
+		if (TutAnimInstance)
+		{
+			TutAnimInstance->Fire();
+		}
+	}
+
+	if (WeaponReplayState.ReloadCount != OldState.ReloadCount)
+	{
+		PlayReloadEffects();
+	}
+}
+
 void AADSTutCharacter::OnRep_OpticIndex()
 {
 	CurrentOptic = Optics[OpticIndex];
@@ -137,17 +394,28 @@ void AADSTutCharacter::OnRep_OpticIndex()
 
 bool AADSTutCharacter::Server_OpticIndex_Validate(uint8 NewIndex)
 {
-	return true;
+	return Optics.IsValidIndex(NewIndex) && !ShouldKickForServerRPC();
 }
 
 void AADSTutCharacter::Server_OpticIndex_Implementation(uint8 NewIndex)
 {
+	if (!ChargeServerRPC())
+	{
+		ThrottledOpticIndex = NewIndex;
+		ScheduleThrottledServerState();
+		return;
+	}
+
+	ThrottledOpticIndex.Reset();
 	OpticIndex = NewIndex;
 	OnRep_OpticIndex();
+	NoteCombatActivity();
 }
 
 void AADSTutCharacter::CycleOptic()
 {
+	NoteCombatActivity();
+
 	if (++OpticIndex >= Optics.Num())
 	{
 		OpticIndex = 0;
@@ -167,6 +435,41 @@ void AADSTutCharacter::CycleOptic()
 
 void AADSTutCharacter::Reload()
 {
+	PlayReloadEffects();
+
+	if (HasAuthority())
+	{
+		++WeaponReplayState.ReloadCount;
+	}
+	else
+	{
+		Server_Reload();
+	}
+}
+
+bool AADSTutCharacter::Server_Reload_Validate()
+{
+	return !ShouldKickForServerRPC();
+}
+
+void AADSTutCharacter::Server_Reload_Implementation()
+{
+	// Events over budget are dropped, there is no state to catch up on
+	if (!ChargeServerRPC())
+	{
+		return;
+	}
+
+	Reload();
+}
+
+void AADSTutCharacter::PlayReloadEffects()
+{
+	if (IsRunningDedicatedServer())
+	{
+		return;
+	}
+
 	if (ReloadAnimation)
 	{
 		// Get the animation object for the arms mesh
@@ -205,6 +508,41 @@ void AADSTutCharacter::OnFire()
 		}
 	}
 
+	PlayFireEffects();
+
+	if (HasAuthority())
+	{
+		++WeaponReplayState.FireCount;
+		NoteCombatActivity();
+	}
+	else
+	{
+		Server_Fire();
+	}
+}
+
+bool AADSTutCharacter::Server_Fire_Validate()
+{
+	return !ShouldKickForServerRPC();
+}
+
+void AADSTutCharacter::Server_Fire_Implementation()
+{
+	if (!ChargeServerRPC())
+	{
+		return;
+	}
+
+	OnFire();
+}
+
+void AADSTutCharacter::PlayFireEffects()
+{
+	if (IsRunningDedicatedServer())
+	{
+		return;
+	}
+
 	// try and play the sound if specified
 	if (FireSound != nullptr)
 	{
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 
 #include "GameFramework/Character.h"
+#include "UObject/PrimaryAssetId.h"
+#include "ADSTutRPCRateLimiter.h"
+#include "ADSTutTimingWheel.h"
 #include "ADSTutCharacter.generated.h"
 
 class UInputComponent;
@@ -17,6 +20,31 @@ class USoundBase;
 class UStaticMeshComponent;
 class UIKAnimInstance;
 
+DECLARE_MULTICAST_DELEGATE(FOnWeaponReady);
+
+/** Weapon events that only exist on the owning client, recorded so replays can play them back */
+USTRUCT()
+struct FWeaponReplayState
+{
+	GENERATED_BODY()
+
+	/** Wrapping counters, replay playback triggers one event per increment */
+	UPROPERTY()
+	uint8 FireCount = 0;
+	UPROPERTY()
+	uint8 ReloadCount = 0;
+};
+
+/** What the server does with a client that keeps sending RPCs over its budget */
+UENUM()
+enum class ERPCFloodPolicy : uint8
+{
+	/** Drop event RPCs that are over budget, apply the latest state RPC once the budget refills */
+	Throttle,
+	/** Fail validation, which disconnects the client */
+	Kick
+};
+
 UCLASS(config=Game)
 class AADSTutCharacter : public ACharacter
 {
@@ -35,8 +63,6 @@ protected:
 	TArray<UStaticMeshComponent*> Optics;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TUTORIAL")
 	UStaticMeshComponent* CurrentOptic;
-	UPROPERTY(ReplicatedUsing = OnRep_OpticIndex)
-	uint8 OpticIndex;
 	UFUNCTION()
 	void OnRep_OpticIndex();
 	UFUNCTION(Server, Reliable, WithValidation)
@@ -50,7 +76,9 @@ public:
 	AADSTutCharacter();
 
 protected:
+	virtual void PreRegisterAllComponents() override;
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
@@ -75,27 +103,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	UAnimMontage* ReloadAnimation;
 
-protected:
-	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
-	UIKAnimInstance* TutAnimInstance;
+	/** Loadout streamed in before the weapon is ready, leave empty to keep the assets set on the Blueprint */
+	UPROPERTY(EditDefaultsOnly, Category = Gameplay, meta = (AllowedTypes = "Loadout"))
+	FPrimaryAssetId LoadoutId;
 
-	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	/** Broadcast once the loadout is applied and the gun attached, sockets used for IK are valid from then on */
+	FOnWeaponReady OnWeaponReady;
+
+	bool IsWeaponReady() const { return bWeaponReady; }
+
+	bool IsAimingDownSights() const { return bIsAiming; }
+
+	// Gameplay actions, bound to input for players and called directly by scripted drivers such as UADSTutBotComponent
 
 	UFUNCTION(BlueprintCallable, Category = "TUTORIAL")
 	void SetAiming(bool IsAiming);
-	UPROPERTY(ReplicatedUsing = OnRep_IsAiming)
-	bool bIsAiming;
-	UFUNCTION()
-	void OnRep_IsAiming();
-	UFUNCTION(Server, Reliable, WithValidation)
-	void Server_SetAiming(bool IsAiming);
-	
+
 	UFUNCTION(BlueprintCallable, Category = "TUTORIAL")
 	void CycleOptic();
 
 	UFUNCTION(BlueprintCallable, Category = "TUTORIAL")
 	void Reload();
-	
+
 	/** Fires a projectile. */
 	void OnFire();
 
@@ -105,6 +134,100 @@ protected:
 	/** Handles stafing movement, left and right */
 	void MoveRight(float Val);
 
+	/** Server RPCs a client may send per second once its burst is used up */
+	UPROPERTY(Config, EditDefaultsOnly, Category = Network)
+	float ServerRPCRate;
+
+	/** Server RPCs a client may send back to back */
+	UPROPERTY(Config, EditDefaultsOnly, Category = Network)
+	float ServerRPCBurst;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = Network)
+	ERPCFloodPolicy ServerRPCFloodPolicy;
+
+	/** How long aiming, optic changes or firing keep the character at combat net priority */
+	UPROPERTY(EditDefaultsOnly, Category = Network)
+	float CombatActivityWindow;
+
+	/**
+	 * Net priority multiplier while in combat, so duelling players win bandwidth over idle ones.
+	 * Update rate can't follow the distance to each viewer without the ReplicationGraph, since
+	 * NetUpdateFrequency is shared by every connection. Distance reaches bandwidth through the
+	 * distance term of the pawn's net priority instead.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = Network)
+	float CombatNetPriorityScale;
+
+	/** True while aiming, optic changes or firing happened within CombatActivityWindow */
+	bool IsInCombat() const;
+
+protected:
+	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
+	UIKAnimInstance* TutAnimInstance;
+
+	// Per character state is packed here in one block, the flags share a byte and nothing pads between them
+
+	UPROPERTY(ReplicatedUsing = OnRep_IsAiming)
+	uint8 bIsAiming : 1;
+	uint8 bWeaponReady : 1;
+	/** The first replicated weapon replay state is the counters' starting point, not an event */
+	uint8 bReceivedWeaponReplayState : 1;
+
+	UPROPERTY(ReplicatedUsing = OnRep_OpticIndex)
+	uint8 OpticIndex;
+
+	/** Aim and optic already reach replays through their own properties, this carries fire and reload */
+	UPROPERTY(ReplicatedUsing = OnRep_WeaponReplayState)
+	FWeaponReplayState WeaponReplayState;
+
+	/** Server time of the last aim, optic or fire event */
+	float LastCombatActivityTime;
+
+	/** Server RPCs of a pawn only come from its owning connection, so this is the per-connection budget */
+	FRPCRateLimiter ServerRPCLimiter;
+
+	/** Latest state sent while over budget, applied when the budget refills */
+	TOptional<bool> ThrottledAiming;
+	TOptional<uint8> ThrottledOpticIndex;
+	FWheelTimerHandle ThrottledStateHandle;
+
+	/** Streams in the loadout bundles this machine needs, then applies them */
+	void RequestLoadout();
+	void OnLoadoutLoaded();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	/** On the server, raises net priority for a while and wakes replication from its idle rate */
+	void NoteCombatActivity();
+
+	/** Used by the _Validate functions, true if the client is out of budget under the Kick policy */
+	bool ShouldKickForServerRPC() const;
+
+	/** Charges one server RPC to the owning connection, returns false if it is over budget */
+	bool ChargeServerRPC();
+
+	void ScheduleThrottledServerState();
+	void ApplyThrottledServerState();
+
+	UFUNCTION()
+	void OnRep_IsAiming();
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_SetAiming(bool IsAiming);
+
+	UFUNCTION()
+	void OnRep_WeaponReplayState(const FWeaponReplayState& OldState);
+
+	/** Unreliable, it only exists to advance the replay counter and a lost one costs a single recorded event */
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void Server_Reload();
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void Server_Fire();
+
+	/** Plays the cosmetic part of a shot or reload without touching replication */
+	void PlayFireEffects();
+	void PlayReloadEffects();
+
 	/**
 	 * Called via input to turn at a given rate.
 	 * @param Rate	This is a normalized rate, i.e. 1.0 means 100% of desired turn rate
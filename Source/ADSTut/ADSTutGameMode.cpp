@@ -1,8 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ADSTutGameMode.h"
+#include "ADSTut.h"
 #include "ADSTutHUD.h"
 #include "ADSTutCharacter.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
 #include "UObject/ConstructorHelpers.h"
 
 AADSTutGameMode::AADSTutGameMode()
@@ -14,4 +19,61 @@ AADSTutGameMode::AADSTutGameMode()
 
 	// use our custom HUD class
 	//HUDClass = AADSTutHUD::StaticClass();
+
+	// Only does work while a CSV capture runs, see RecordConnectionStats
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AADSTutGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	RecordConnectionStats();
+}
+
+void AADSTutGameMode::RecordConnectionStats()
+{
+#if CSV_PROFILER
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver || !FCsvProfiler::Get()->IsCapturing())
+	{
+		return;
+	}
+
+	// The engine's own net stats are totals over every connection. Per connection columns, plus the
+	// spread across them, show whether a few players take most of the bandwidth
+	const int32 CategoryIndex = CSV_CATEGORY_INDEX(ADSTut);
+	int32 MinOutBytes = MAX_int32;
+	int32 MaxOutBytes = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		const APlayerState* PlayerState = Connection && Connection->PlayerController ? Connection->PlayerController->PlayerState : nullptr;
+		if (!PlayerState)
+		{
+			continue;
+		}
+
+		const int32 PlayerId = PlayerState->GetPlayerId();
+		const TPair<FName, FName>* StatNames = ConnectionStatNames.Find(PlayerId);
+		if (!StatNames)
+		{
+			StatNames = &ConnectionStatNames.Add(PlayerId, TPair<FName, FName>(
+				*FString::Printf(TEXT("Player%d_OutBytesPerSecond"), PlayerId),
+				*FString::Printf(TEXT("Player%d_InBytesPerSecond"), PlayerId)));
+		}
+
+		// Both are updated by the connection once per stat period, so they step rather than vary per frame
+		FCsvProfiler::RecordCustomStat(StatNames->Key, CategoryIndex, Connection->OutBytesPerSecond, ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(StatNames->Value, CategoryIndex, Connection->InBytesPerSecond, ECsvCustomStatOp::Set);
+
+		MinOutBytes = FMath::Min(MinOutBytes, Connection->OutBytesPerSecond);
+		MaxOutBytes = FMath::Max(MaxOutBytes, Connection->OutBytesPerSecond);
+	}
+
+	if (MaxOutBytes >= MinOutBytes)
+	{
+		CSV_CUSTOM_STAT(ADSTut, ConnectionOutBytesPerSecondMin, MinOutBytes, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(ADSTut, ConnectionOutBytesPerSecondMax, MaxOutBytes, ECsvCustomStatOp::Set);
+	}
+#endif
 }
@@ -13,6 +13,15 @@ class AADSTutGameMode : public AGameModeBase
 
 public:
 	AADSTutGameMode();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	/** Records bandwidth for every client connection while a CSV capture is running */
+	void RecordConnectionStats();
+
+	/** Per player CSV stat names, built once rather than formatted every frame */
+	TMap<int32, TPair<FName, FName>> ConnectionStatNames;
 };
 
 
@@ -5,13 +5,26 @@
 #include "Engine/Texture2D.h"
 #include "TextureResource.h"
 #include "CanvasItem.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Engine/AssetManager.h"
 
 AADSTutHUD::AADSTutHUD()
 {
 	// Set the crosshair texture
-	static ConstructorHelpers::FObjectFinder<UTexture2D> CrosshairTexObj(TEXT("/Game/FirstPerson/Textures/FirstPersonCrosshair"));
-	CrosshairTex = CrosshairTexObj.Object;
+	CrosshairTexture = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/FirstPerson/Textures/FirstPersonCrosshair.FirstPersonCrosshair")));
+	CrosshairTex = nullptr;
+}
+
+void AADSTutHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(CrosshairTexture.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &AADSTutHUD::OnCrosshairLoaded));
+}
+
+void AADSTutHUD::OnCrosshairLoaded()
+{
+	CrosshairTex = CrosshairTexture.Get();
 }
 
 
@@ -19,6 +32,11 @@ void AADSTutHUD::DrawHUD()
 {
 	Super::DrawHUD();
 
+	if (!CrosshairTex)
+	{
+		return;
+	}
+
 	// Draw very simple crosshair
 
 	// find center of the Canvas
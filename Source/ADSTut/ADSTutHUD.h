@@ -17,9 +17,19 @@ public:
 	/** Primary draw call for the HUD */
 	virtual void DrawHUD() override;
 
+protected:
+	virtual void BeginPlay() override;
+
 private:
-	/** Crosshair asset pointer */
+	/** Crosshair asset, streamed in on BeginPlay */
+	UPROPERTY(EditDefaultsOnly, Category = HUD)
+	TSoftObjectPtr<class UTexture2D> CrosshairTexture;
+
+	/** Crosshair asset pointer, null until the texture has loaded */
+	UPROPERTY()
 	class UTexture2D* CrosshairTex;
 
+	void OnCrosshairLoaded();
+
 };
 
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTutImpactSubsystem.h"
+#include "ADSTutProjectile.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+bool UADSTutImpactSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UADSTutImpactSubsystem::QueueImpact(AADSTutProjectile* Projectile, UPrimitiveComponent* HitComponent, const FVector& Impulse, const FVector& Location)
+{
+	PendingImpacts.Add({ Projectile, HitComponent, Impulse, Location });
+}
+
+bool UADSTutImpactSubsystem::IsTickable() const
+{
+	// The CDO registers as a tickable object too
+	return !IsTemplate() && PendingImpacts.Num() > 0;
+}
+
+TStatId UADSTutImpactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UADSTutImpactSubsystem, STATGROUP_Tickables);
+}
+
+void UADSTutImpactSubsystem::Tick(float DeltaTime)
+{
+	// Many hits on the same body collapse into one linear and one angular impulse
+	for (const FImpact& Impact : PendingImpacts)
+	{
+		UPrimitiveComponent* HitComponent = Impact.HitComponent.Get();
+		if (HitComponent && HitComponent->IsSimulatingPhysics())
+		{
+			FBodyImpulse& BodyImpulse = BodyImpulses.FindOrAdd(HitComponent);
+			BodyImpulse.Linear += Impact.Impulse;
+			BodyImpulse.Angular += FVector::CrossProduct(Impact.Location - HitComponent->GetCenterOfMass(), Impact.Impulse);
+		}
+	}
+
+	for (const TPair<UPrimitiveComponent*, FBodyImpulse>& Pair : BodyImpulses)
+	{
+		Pair.Key->AddImpulse(Pair.Value.Linear);
+		Pair.Key->AddAngularImpulseInRadians(Pair.Value.Angular);
+	}
+
+	for (const FImpact& Impact : PendingImpacts)
+	{
+		AADSTutProjectile* Projectile = Impact.Projectile.Get();
+		if (Projectile && !Projectile->IsPendingKill())
+		{
+			Projectile->Destroy();
+			++NumProjectilesDestroyed;
+		}
+	}
+
+	NumImpactsResolved += PendingImpacts.Num();
+	PendingImpacts.Reset();
+	BodyImpulses.Reset();
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ADSTutImpactSubsystem.generated.h"
+
+class AADSTutProjectile;
+class UPrimitiveComponent;
+
+/**
+ * Collects projectile hits during movement and resolves them in one pass once movement is done.
+ * Keeps the physics callbacks cheap and turns a burst of hits on one body into a single impulse.
+ */
+UCLASS()
+class UADSTutImpactSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Queues a hit for this frame's impact stage, which also destroys the projectile */
+	void QueueImpact(AADSTutProjectile* Projectile, UPrimitiveComponent* HitComponent, const FVector& Impulse, const FVector& Location);
+
+	int32 GetNumPendingImpacts() const { return PendingImpacts.Num(); }
+
+	/** Totals since the world started, every queued impact should destroy exactly one projectile */
+	int64 GetNumImpactsResolved() const { return NumImpactsResolved; }
+	int64 GetNumProjectilesDestroyed() const { return NumProjectilesDestroyed; }
+
+	// FTickableGameObject interface, ticks after the physics tick groups so every hit of the frame is in
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	struct FImpact
+	{
+		TWeakObjectPtr<AADSTutProjectile> Projectile;
+		TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+		FVector Impulse;
+		FVector Location;
+	};
+
+	/** Summed linear and angular impulse for one body, equivalent to applying each hit at its location */
+	struct FBodyImpulse
+	{
+		FVector Linear = FVector::ZeroVector;
+		FVector Angular = FVector::ZeroVector;
+	};
+
+	TArray<FImpact> PendingImpacts;
+
+	/** Kept between frames so the impact stage doesn't allocate once warmed up */
+	TMap<UPrimitiveComponent*, FBodyImpulse> BodyImpulses;
+
+	int64 NumImpactsResolved = 0;
+	int64 NumProjectilesDestroyed = 0;
+};
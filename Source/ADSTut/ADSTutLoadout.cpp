@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTutLoadout.h"
+#include "ADSTut.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "UObject/UObjectGlobals.h"
+
+const FPrimaryAssetType UADSTutLoadout::PrimaryAssetType(TEXT("Loadout"));
+
+TArray<FName> UADSTutLoadout::GetBundlesToLoad()
+{
+	if (IsRunningDedicatedServer())
+	{
+		return { TEXT("Gun"), TEXT("Optics") };
+	}
+	return { TEXT("Arms"), TEXT("Gun"), TEXT("Optics"), TEXT("Montages"), TEXT("Sway") };
+}
+
+FPrimaryAssetId UADSTutLoadout::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+bool UADSTutLoadoutSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UADSTutLoadoutSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The world is created at the start of the map load, before any of its actors are
+	WorldCreatedTime = FPlatformTime::Seconds();
+	MapLoadedTime = WorldCreatedTime;
+	FirstADSPoseTime = 0.0;
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UADSTutLoadoutSubsystem::OnPostLoadMap);
+
+	if (UAssetManager* AssetManager = UAssetManager::GetIfValid())
+	{
+		PreloadHandle = AssetManager->LoadPrimaryAssetsWithType(UADSTutLoadout::PrimaryAssetType, UADSTutLoadout::GetBundlesToLoad());
+	}
+}
+
+void UADSTutLoadoutSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	PreloadHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+void UADSTutLoadoutSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	// PIE worlds don't go through LoadMap, they keep the world creation time
+	if (LoadedWorld == GetWorld())
+	{
+		MapLoadedTime = FPlatformTime::Seconds();
+		UE_LOG(LogADSTutLoad, Log, TEXT("%s loaded in %.3fs"), *LoadedWorld->GetMapName(), MapLoadedTime - WorldCreatedTime);
+	}
+}
+
+void UADSTutLoadoutSubsystem::NotifyADSPoseReady()
+{
+	if (HasADSPoseReady())
+	{
+		return;
+	}
+
+	FirstADSPoseTime = FPlatformTime::Seconds();
+	UE_LOG(LogADSTutLoad, Log, TEXT("First valid ADS pose %.3fs after the map loaded, %.3fs after the world was created"),
+		GetADSPoseSecondsAfterMapLoad(), FirstADSPoseTime - WorldCreatedTime);
+	CSV_EVENT(ADSTut, TEXT("FirstADSPose"));
+}
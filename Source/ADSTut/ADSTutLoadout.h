@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ADSTutLoadout.generated.h"
+
+class USkeletalMesh;
+class UStaticMesh;
+class UAnimMontage;
+class UCurveVector;
+struct FStreamableHandle;
+
+/** Weapon assets for a character, split into bundles so each machine only streams what it needs */
+UCLASS()
+class UADSTutLoadout : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Asset manager type every loadout is registered under */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/** Bundles to load on this machine, a dedicated server only needs what hit validation uses */
+	static TArray<FName> GetBundlesToLoad();
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Arms"))
+	TSoftObjectPtr<USkeletalMesh> ArmsMesh;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Gun"))
+	TSoftObjectPtr<USkeletalMesh> GunMesh;
+
+	/** Applied in order to the character's optic components */
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Optics"))
+	TArray<TSoftObjectPtr<UStaticMesh>> OpticMeshes;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Montages"))
+	TSoftObjectPtr<UAnimMontage> FireAnimation;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Montages"))
+	TSoftObjectPtr<UAnimMontage> ReloadAnimation;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (AssetBundles = "Sway"))
+	TSoftObjectPtr<UCurveVector> SwayCurve;
+};
+
+/**
+ * Starts streaming every loadout while the map loads, so characters rarely wait on their own request.
+ * Also times the map load against the first character with a valid ADS pose.
+ */
+UCLASS()
+class UADSTutLoadoutSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Called by the anim instance once its IK transforms are valid, only the first call in a world is recorded */
+	void NotifyADSPoseReady();
+
+	bool HasADSPoseReady() const { return FirstADSPoseTime > 0.0; }
+
+	/** Seconds from the map finishing its load to the first valid ADS pose, negative if the pose came first */
+	double GetADSPoseSecondsAfterMapLoad() const { return FirstADSPoseTime - MapLoadedTime; }
+
+private:
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	/** FPlatformTime::Seconds() stamps, so time spent loading counts even though the world clock doesn't run */
+	double WorldCreatedTime;
+	double MapLoadedTime;
+	double FirstADSPoseTime;
+};
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ADSTutProjectile.h"
+#include "ADSTutImpactSubsystem.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
 
@@ -36,8 +37,20 @@ void AADSTutProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
 	// Only add impulse and destroy projectile if we hit a physics
 	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
 	{
-		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
-
-		Destroy();
+		// Impulse and destruction happen in the batched impact stage after movement, not inside the sweep
+		if (UADSTutImpactSubsystem* ImpactSubsystem = GetWorld()->GetSubsystem<UADSTutImpactSubsystem>())
+		{
+			ImpactSubsystem->QueueImpact(this, OtherComp, GetVelocity() * 100.0f, GetActorLocation());
+			ProjectileMovement->StopSimulating(Hit);
+
+			// Out of the world until the impact stage destroys it, so nothing else hits or pushes into it this frame
+			CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			SetActorHiddenInGame(true);
+		}
+		else
+		{
+			OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+			Destroy();
+		}
 	}
 }
\ No newline at end of file
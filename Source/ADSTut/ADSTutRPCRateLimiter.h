@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Token bucket for RPCs coming from a single client.
+ * Only touched on the game thread, so the counters are plain integers.
+ */
+struct FRPCRateLimiter
+{
+	/** Starts full, the first refill clamps this down to the burst size */
+	float Tokens = TNumericLimits<float>::Max();
+	float LastRefillTime = 0.0f;
+
+	/** RPCs rejected since the client was last under budget */
+	uint32 DroppedCount = 0;
+
+	/** True if TryConsume would succeed at Now, without changing the bucket */
+	bool WouldAllow(float Now, float RefillRate, float BurstSize) const
+	{
+		return FMath::Min(BurstSize, Tokens + (Now - LastRefillTime) * RefillRate) >= 1.0f;
+	}
+
+	/** Refills the bucket up to Now and takes one token, returns false if there was none left */
+	bool TryConsume(float Now, float RefillRate, float BurstSize)
+	{
+		Tokens = FMath::Min(BurstSize, Tokens + (Now - LastRefillTime) * RefillRate);
+		LastRefillTime = Now;
+
+		if (Tokens < 1.0f)
+		{
+			++DroppedCount;
+			return false;
+		}
+
+		Tokens -= 1.0f;
+		DroppedCount = 0;
+		return true;
+	}
+
+	/** Seconds after the last refill until a token is available again */
+	float GetSecondsUntilToken(float RefillRate) const
+	{
+		return Tokens >= 1.0f ? 0.0f : (1.0f - Tokens) / RefillRate;
+	}
+};
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTutTimerSubsystem.h"
+
+#include "Engine/World.h"
+
+bool UADSTutTimerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UADSTutTimerSubsystem::Tick(float DeltaTime)
+{
+	TimingWheel.Advance(DeltaTime);
+}
+
+bool UADSTutTimerSubsystem::IsTickable() const
+{
+	// The CDO registers as a tickable object too
+	return !IsTemplate();
+}
+
+TStatId UADSTutTimerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UADSTutTimerSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ADSTutTimingWheel.h"
+#include "ADSTutTimerSubsystem.generated.h"
+
+/**
+ * Per world timing wheel for the short gameplay timers of characters and their anim instances.
+ * Meant for bursts like round start, when hundreds of pawns schedule at once. ADSTut.Timers.RoundStartCost
+ * times that case against FTimerManager.
+ */
+UCLASS()
+class UADSTutTimerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	FTimingWheel& GetTimingWheel() { return TimingWheel; }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** 120Hz ticks, finer than any frame so timers never fire a frame late from rounding */
+	FTimingWheel TimingWheel{ 1.0f / 120.0f };
+};
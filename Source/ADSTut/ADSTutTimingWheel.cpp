@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTutTimingWheel.h"
+
+FTimingWheel::FTimingWheel(float InTickSeconds)
+	: TickSeconds(InTickSeconds)
+	, Accumulator(0.0f)
+	, CurrentTick(0)
+	, NumScheduled(0)
+	, FreeHead(INDEX_NONE)
+{
+	check(TickSeconds > 0.0f);
+
+	for (int32& Head : SlotHeads)
+	{
+		Head = INDEX_NONE;
+	}
+}
+
+FWheelTimerHandle FTimingWheel::Schedule(float DelaySeconds, FSimpleDelegate Callback)
+{
+	int32 TimerIndex = FreeHead;
+	if (TimerIndex != INDEX_NONE)
+	{
+		FreeHead = Timers[TimerIndex].Next;
+	}
+	else
+	{
+		TimerIndex = Timers.AddDefaulted();
+	}
+
+	// Always at least one tick out, the current tick's slot has already fired
+	const uint64 DelayTicks = uint64(FMath::Clamp<double>(FMath::CeilToDouble(DelaySeconds / TickSeconds), 1.0, double(MaxDelayTicks)));
+
+	FTimer& Timer = Timers[TimerIndex];
+	Timer.Callback = MoveTemp(Callback);
+	Timer.ExpireTick = CurrentTick + DelayTicks;
+	Insert(TimerIndex);
+	++NumScheduled;
+
+	FWheelTimerHandle Handle;
+	Handle.Index = TimerIndex;
+	Handle.Generation = Timer.Generation;
+	return Handle;
+}
+
+void FTimingWheel::Cancel(FWheelTimerHandle& Handle)
+{
+	if (IsScheduled(Handle))
+	{
+		Unlink(Handle.Index);
+		Release(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+
+bool FTimingWheel::IsScheduled(const FWheelTimerHandle& Handle) const
+{
+	return Handle.IsValid() && Timers.IsValidIndex(Handle.Index)
+		&& Timers[Handle.Index].Generation == Handle.Generation && Timers[Handle.Index].Slot != INDEX_NONE;
+}
+
+void FTimingWheel::Advance(float DeltaSeconds)
+{
+	Accumulator += DeltaSeconds;
+	const int32 NumSteps = FMath::FloorToInt(Accumulator / TickSeconds);
+	Accumulator -= NumSteps * TickSeconds;
+
+	for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+	{
+		if (NumScheduled == 0)
+		{
+			// Nothing to cascade or fire, skip the rest of the steps
+			CurrentTick += NumSteps - StepIndex;
+			return;
+		}
+		Step();
+	}
+}
+
+void FTimingWheel::Step()
+{
+	++CurrentTick;
+
+	// A level cascades each time every level below it wraps. Go top down so timers moving out of
+	// a higher level can land in a lower level slot that is cascading on this same tick
+	int32 TopLevel = 0;
+	while (TopLevel + 1 < NumLevels && (CurrentTick & ((uint64(1) << (SlotBits * (TopLevel + 1))) - 1)) == 0)
+	{
+		++TopLevel;
+	}
+
+	for (int32 Level = TopLevel; Level > 0; --Level)
+	{
+		const int32 Slot = Level * SlotsPerLevel + int32((CurrentTick >> (SlotBits * Level)) & SlotMask);
+		while (SlotHeads[Slot] != INDEX_NONE)
+		{
+			const int32 TimerIndex = SlotHeads[Slot];
+			Unlink(TimerIndex);
+			Insert(TimerIndex);
+		}
+	}
+
+	// Pop one at a time, callbacks may cancel other timers in this slot. Anything they schedule is at
+	// least a tick out and never lands here
+	const int32 Slot = int32(CurrentTick & SlotMask);
+	while (SlotHeads[Slot] != INDEX_NONE)
+	{
+		const int32 TimerIndex = SlotHeads[Slot];
+		Unlink(TimerIndex);
+
+		FSimpleDelegate Callback = MoveTemp(Timers[TimerIndex].Callback);
+		Release(TimerIndex);
+		Callback.ExecuteIfBound();
+	}
+}
+
+void FTimingWheel::Insert(int32 TimerIndex)
+{
+	const uint64 ExpireTick = Timers[TimerIndex].ExpireTick;
+	const uint64 DelayTicks = ExpireTick - CurrentTick;
+
+	// The level is picked by how far out the timer is, the slot by the expiry bits at that level
+	int32 Level = 0;
+	while (Level + 1 < NumLevels && DelayTicks >= (uint64(1) << (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+
+	Link(TimerIndex, Level * SlotsPerLevel + int32((ExpireTick >> (SlotBits * Level)) & SlotMask));
+}
+
+void FTimingWheel::Link(int32 TimerIndex, int32 Slot)
+{
+	FTimer& Timer = Timers[TimerIndex];
+	Timer.Slot = Slot;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = SlotHeads[Slot];
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = TimerIndex;
+	}
+	SlotHeads[Slot] = TimerIndex;
+}
+
+void FTimingWheel::Unlink(int32 TimerIndex)
+{
+	FTimer& Timer = Timers[TimerIndex];
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		SlotHeads[Timer.Slot] = Timer.Next;
+	}
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+}
+
+void FTimingWheel::Release(int32 TimerIndex)
+{
+	FTimer& Timer = Timers[TimerIndex];
+	Timer.Callback.Unbind();
+	Timer.Slot = INDEX_NONE;
+	// Outstanding handles to this timer stop matching
+	++Timer.Generation;
+	Timer.Next = FreeHead;
+	FreeHead = TimerIndex;
+	--NumScheduled;
+}
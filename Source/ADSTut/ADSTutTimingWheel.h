@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Handle to a timer in an FTimingWheel, an index and a generation so copying or storing it never allocates */
+struct FWheelTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; }
+};
+
+/**
+ * Hierarchical timing wheel for short one-shot timers.
+ * Scheduling and cancelling are O(1). Timers live in a pool that only grows, so once warmed up
+ * nothing allocates. Delays are rounded up to whole ticks of TickSeconds.
+ */
+class FTimingWheel
+{
+public:
+	explicit FTimingWheel(float InTickSeconds);
+
+	/** Runs Callback once, DelaySeconds from now */
+	FWheelTimerHandle Schedule(float DelaySeconds, FSimpleDelegate Callback);
+
+	/** Cancels the timer if it hasn't fired yet and invalidates the handle */
+	void Cancel(FWheelTimerHandle& Handle);
+
+	bool IsScheduled(const FWheelTimerHandle& Handle) const;
+
+	/** Moves time forward, firing every timer that expires on the way */
+	void Advance(float DeltaSeconds);
+
+private:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr int32 SlotMask = SlotsPerLevel - 1;
+	static constexpr int32 NumLevels = 4;
+	static constexpr uint64 MaxDelayTicks = (uint64(1) << (SlotBits * NumLevels)) - 1;
+
+	struct FTimer
+	{
+		FSimpleDelegate Callback;
+		uint64 ExpireTick = 0;
+		/** Intrusive list links within a slot, or the free list */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		/** Slot the timer is linked into, INDEX_NONE while free */
+		int32 Slot = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	void Step();
+	void Insert(int32 TimerIndex);
+	void Link(int32 TimerIndex, int32 Slot);
+	void Unlink(int32 TimerIndex);
+	void Release(int32 TimerIndex);
+
+	float TickSeconds;
+	float Accumulator;
+	uint64 CurrentTick;
+	int32 NumScheduled;
+
+	TArray<FTimer> Timers;
+	int32 FreeHead;
+	int32 SlotHeads[NumLevels * SlotsPerLevel];
+};
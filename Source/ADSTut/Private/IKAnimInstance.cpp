@@ -2,21 +2,24 @@
 
 
 #include "IKAnimInstance.h"
+#include "IKAnimMath.h"
 #include "ADSTut/ADSTutCharacter.h"
+#include "ADSTut/ADSTutLoadout.h"
 
 #include "GameFramework/PawnMovementComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Curves/CurveVector.h"
 
+using namespace IKAnimMath;
+
 UIKAnimInstance::UIKAnimInstance()
 {
 	AimAlpha = 0.0f;
-	bInterpAiming = false;
-	bIsAiming = false;
-	bInterpRelativeHand = false;
-
 	ReloadAlpha = 1.0f;
+
+	FinalHandRotation = FQuat::Identity;
+	FinalHandLocation = FVector::ZeroVector;
 }
 
 void UIKAnimInstance::NativeBeginPlay()
@@ -25,14 +28,18 @@ void UIKAnimInstance::NativeBeginPlay()
 
 	Character = Cast<AADSTutCharacter>(TryGetPawnOwner());
 
-	if (Character)
+	if (Character && !IsRunningDedicatedServer())
 	{
-		FTimerHandle TSetSightTransform;
-		FTimerHandle TSetRelativeHandTransform;
-		GetWorld()->GetTimerManager().SetTimer(TSetSightTransform, this, &UIKAnimInstance::SetSightTransform, 0.3f, false);
-		GetWorld()->GetTimerManager().SetTimer(TSetRelativeHandTransform, this, &UIKAnimInstance::SetRelativeHandTransform, 0.3f, false);
+		if (Character->IsWeaponReady())
+		{
+			OnWeaponReady();
+		}
+		else
+		{
+			Character->OnWeaponReady.AddUObject(this, &UIKAnimInstance::OnWeaponReady);
+		}
 
-		OldRotation = Character->GetControlRotation();
+		Hot.OldRotation = Character->GetControlRotation();
 	}
 }
 
@@ -42,30 +49,54 @@ void UIKAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 
 	if (!Character) {return;}
 
-	if (bInterpAiming)
+	if (Hot.bPendingIKSetup)
 	{
-		InterpAiming(DeltaSeconds);
-	}
+		// Wait for an update after the weapon is ready so the sockets come from an evaluated pose
+		SetSightTransform();
+		SetRelativeHandTransform();
+		Hot.bPendingIKSetup = false;
 
-	if (bInterpRelativeHand)
-	{
-		InterpRelativeHand(DeltaSeconds);
+		if (UADSTutLoadoutSubsystem* LoadoutSubsystem = GetWorld()->GetSubsystem<UADSTutLoadoutSubsystem>())
+		{
+			LoadoutSubsystem->NotifyADSPoseReady();
+		}
 	}
 
+	UpdateInterpolation(DeltaSeconds);
+
 	if (Character->IsLocallyControlled())
 	{
 		RotateWithRotation(DeltaSeconds);
 		MoveVectorCurve(DeltaSeconds);
+	}
 
-		if (!RecoilTransform.Equals(FTransform()) || !FinalRecoilTransform.Equals(FTransform()))
-		{
-			InterpRecoil(DeltaSeconds);
-			InterpFinalRecoil(DeltaSeconds);
-		}
-	}	
 	SetLeftHandIK();
 }
 
+void UIKAnimInstance::UpdateInterpolation(float DeltaSeconds)
+{
+	if (Hot.bInterpAiming)
+	{
+		InterpAiming(DeltaSeconds);
+	}
+
+	if (Hot.bInterpRelativeHand)
+	{
+		InterpRelativeHand(DeltaSeconds);
+	}
+
+	// Also runs for replay playback, where the recorded pawn is never locally controlled
+	if (!RecoilTransform.Equals(FTransform()) || !Hot.FinalRecoilLocation.IsNearlyZero() || !Hot.FinalRecoilRotationLog.IsNearlyZero())
+	{
+		InterpRecoil(DeltaSeconds);
+	}
+}
+
+void UIKAnimInstance::OnWeaponReady()
+{
+	Hot.bPendingIKSetup = true;
+}
+
 void UIKAnimInstance::SetSightTransform()
 {
 	FTransform CamTransform = Character->GetFirstPersonCameraComponent()->GetComponentTransform();
@@ -94,7 +125,9 @@ void UIKAnimInstance::SetFinalHandTransform()
 		FTransform OpticSocketTransform = Character->GetCurrentOptic()->GetSocketTransform(FName("S_Aim"));
 		FTransform MeshTransform = Character->GetMesh1P()->GetSocketTransform(FName("hand_r"));
 
-		FinalHandTransform = UKismetMathLibrary::MakeRelativeTransform(OpticSocketTransform, MeshTransform);
+		const FTransform FinalHandTransform = UKismetMathLibrary::MakeRelativeTransform(OpticSocketTransform, MeshTransform);
+		FinalHandRotation = FinalHandTransform.GetRotation();
+		FinalHandLocation = FinalHandTransform.GetLocation();
 	}
 }
 
@@ -108,21 +141,23 @@ void UIKAnimInstance::SetLeftHandIK()
 
 void UIKAnimInstance::InterpAiming(float DeltaSeconds)
 {
-	AimAlpha = UKismetMathLibrary::FInterpTo(AimAlpha, static_cast<float>(bIsAiming), DeltaSeconds, 10.0f);
+	AimAlpha = ExpDecayTo(AimAlpha, static_cast<float>(Hot.bIsAiming), DeltaSeconds, 10.0f);
 	
 	if (AimAlpha >= 1.0f || AimAlpha <= 0.0f)
 	{
-		bInterpAiming = false;
+		Hot.bInterpAiming = false;
 	}
 }
 
 void UIKAnimInstance::InterpRelativeHand(float DeltaSeconds)
 {
-	RelativeHandTransform = UKismetMathLibrary::TInterpTo(RelativeHandTransform, FinalHandTransform, DeltaSeconds, 10.0f);
+	const FTransform FinalHandTransform(FinalHandRotation, FinalHandLocation);
+	RelativeHandTransform = ExpDecayTo(RelativeHandTransform, FinalHandTransform, DeltaSeconds, 10.0f);
 
 	if (RelativeHandTransform.Equals(FinalHandTransform))
 	{
-		bInterpRelativeHand = false;
+		RelativeHandTransform = FinalHandTransform;
+		Hot.bInterpRelativeHand = false;
 	}
 }
 
@@ -137,15 +172,23 @@ void UIKAnimInstance::MoveVectorCurve(float DeltaSeconds)
 		float MaxSpeed = Character->GetMovementComponent()->GetMaxSpeed();
 		Velocity = UKismetMathLibrary::NormalizeToRange(Velocity, (MaxSpeed / 0.3f * -1.0f), MaxSpeed);
 		FVector NewVec = VectorCurve->GetVectorValue(Character->GetGameTimeSinceCreation());
-		SwayLocation = UKismetMathLibrary::VInterpTo(SwayLocation, NewVec, DeltaSeconds, 1.8f) * Velocity;
+		// Filter the curve on its own, scaling the filtered value would feed the velocity back in every frame
+		Hot.SwayCurveLocation = ExpDecayTo(Hot.SwayCurveLocation, NewVec, DeltaSeconds, 1.8f);
+		SwayLocation = Hot.SwayCurveLocation * Velocity;
 	}
 }
 
 void UIKAnimInstance::RotateWithRotation(float DeltaSeconds)
 {
 	FRotator CurrentRotation = Character->GetControlRotation();
-	UnmodifiedTurnRotator = UKismetMathLibrary::RInterpTo(UnmodifiedTurnRotator, CurrentRotation - OldRotation, DeltaSeconds, 4.0f);
-	FRotator TurnRotation = UnmodifiedTurnRotator;
+	if (DeltaSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	// Sway follows turn speed rather than frame rate
+	Hot.UnmodifiedTurnRotator = ExpDecayTo(Hot.UnmodifiedTurnRotator, TurnSwayTarget(CurrentRotation - Hot.OldRotation, DeltaSeconds), DeltaSeconds, 4.0f);
+	FRotator TurnRotation = Hot.UnmodifiedTurnRotator;
 	TurnRotation.Roll = TurnRotation.Pitch;
 	TurnRotation.Pitch = 0.0f;
 
@@ -159,22 +202,22 @@ void UIKAnimInstance::RotateWithRotation(float DeltaSeconds)
 	TurningSwayTransform.SetLocation(TurnLocation);
 	TurningSwayTransform.SetRotation(TurnRotation.Quaternion());
 	
-	OldRotation = CurrentRotation;
+	Hot.OldRotation = CurrentRotation;
 }
 
 void UIKAnimInstance::SetAiming(bool IsAiming)
 {
-	if (bIsAiming != IsAiming)
+	if (Hot.bIsAiming != IsAiming)
 	{
-		bIsAiming = IsAiming;
-		bInterpAiming = true;
+		Hot.bIsAiming = IsAiming;
+		Hot.bInterpAiming = true;
 	}
 }
 
 void UIKAnimInstance::CycledOptic()
 {
 	SetFinalHandTransform();
-	bInterpRelativeHand = true;
+	Hot.bInterpRelativeHand = true;
 }
 
 void UIKAnimInstance::Reload()
@@ -194,26 +237,19 @@ void UIKAnimInstance::StopReload()
 	ReloadAlpha = 1.0f;
 }
 
-void UIKAnimInstance::InterpFinalRecoil(float DeltaSeconds)
-{	// interp to zero
-	FinalRecoilTransform = UKismetMathLibrary::TInterpTo(FinalRecoilTransform, FTransform(), DeltaSeconds, 10.0f);
-}
-
 void UIKAnimInstance::InterpRecoil(float DeltaSeconds)
-{	// interp to finalrecoiltransform
-	RecoilTransform = UKismetMathLibrary::TInterpTo(RecoilTransform, FinalRecoilTransform, DeltaSeconds, 10.0f);
+{	// interp to the final recoil while that interps to zero
+	DecayRecoil(RecoilTransform, Hot.FinalRecoilLocation, Hot.FinalRecoilRotationLog, DeltaSeconds, 10.0f);
 }
 
 void UIKAnimInstance::Fire()
 {
-	FVector RecoilLoc = FinalRecoilTransform.GetLocation();
-	RecoilLoc += FVector (FMath::RandRange(-0.1f, 0.1f),
+	Hot.FinalRecoilLocation += FVector (FMath::RandRange(-0.1f, 0.1f),
 		FMath::RandRange(-3.0f, -1.0f), FMath::RandRange(0.2f, 1.0f));
 	
-	FRotator RecoilRot = FinalRecoilTransform.GetRotation().Rotator();
+	FRotator RecoilRot = LogToQuat(Hot.FinalRecoilRotationLog).Rotator();
 	RecoilRot += FRotator(FMath::RandRange(-5.0f, 5.0f),
 		FMath::RandRange(-1.0f, 1.0f), FMath::RandRange(-3.0f, -1.0f));
 
-	FinalRecoilTransform.SetRotation(RecoilRot.Quaternion());
-	FinalRecoilTransform.SetLocation(RecoilLoc);
+	Hot.FinalRecoilRotationLog = QuatToLog(RecoilRot.Quaternion());
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Frame rate independent filters used by UIKAnimInstance. Kept free of the engine so the
+ * automation tests can run them at any frame rate without a character.
+ */
+namespace IKAnimMath
+{
+	/** Turning sway was tuned against the per frame rotation delta at this frame time */
+	constexpr float TurnSwayReferenceSeconds = 1.0f / 60.0f;
+
+	/**
+	 * Fraction of the remaining distance covered after DeltaSeconds of exponential decay.
+	 * Matches DeltaSeconds * InterpSpeed for small frames, but never overshoots or snaps on long ones.
+	 */
+	inline float ExpDecayAlpha(float DeltaSeconds, float InterpSpeed)
+	{
+		return 1.0f - FMath::Exp(-InterpSpeed * DeltaSeconds);
+	}
+
+	inline float ExpDecayTo(float Current, float Target, float DeltaSeconds, float InterpSpeed)
+	{
+		const float Result = FMath::Lerp(Current, Target, ExpDecayAlpha(DeltaSeconds, InterpSpeed));
+		// Decay never quite arrives, snap like FInterpTo does once close enough
+		return FMath::Square(Target - Result) < SMALL_NUMBER ? Target : Result;
+	}
+
+	inline FVector ExpDecayTo(const FVector& Current, const FVector& Target, float DeltaSeconds, float InterpSpeed)
+	{
+		return FMath::Lerp(Current, Target, ExpDecayAlpha(DeltaSeconds, InterpSpeed));
+	}
+
+	/** Per component, for rotators that hold angular rates rather than orientations and so must not wrap */
+	inline FRotator ExpDecayTo(const FRotator& Current, const FRotator& Target, float DeltaSeconds, float InterpSpeed)
+	{
+		return Current + (Target - Current) * ExpDecayAlpha(DeltaSeconds, InterpSpeed);
+	}
+
+	inline FTransform ExpDecayTo(const FTransform& Current, const FTransform& Target, float DeltaSeconds, float InterpSpeed)
+	{
+		// Same as UKismetMathLibrary::TLerp
+		FTransform NormalizedCurrent = Current;
+		FTransform NormalizedTarget = Target;
+		NormalizedCurrent.NormalizeRotation();
+		NormalizedTarget.NormalizeRotation();
+
+		FTransform Result;
+		Result.Blend(NormalizedCurrent, NormalizedTarget, ExpDecayAlpha(DeltaSeconds, InterpSpeed));
+		return Result;
+	}
+
+	/** This frame's turn, scaled to what it would have been at the reference frame time */
+	inline FRotator TurnSwayTarget(const FRotator& FrameDelta, float DeltaSeconds)
+	{
+		return FrameDelta.GetNormalized() * (TurnSwayReferenceSeconds / DeltaSeconds);
+	}
+
+	/** Rotation as a vector in the quaternion's log space, taking the short way round */
+	inline FVector QuatToLog(FQuat Quat)
+	{
+		Quat.Normalize();
+		if (Quat.W < 0.0f)
+		{
+			Quat = Quat * -1.0f;
+		}
+		const FQuat Log = Quat.Log();
+		return FVector(Log.X, Log.Y, Log.Z);
+	}
+
+	inline FQuat LogToQuat(const FVector& Log)
+	{
+		return FQuat(Log.X, Log.Y, Log.Z, 0.0f).Exp();
+	}
+
+	/**
+	 * Advances recoil by DeltaSeconds. The target decays to identity while Recoil chases it, both at
+	 * InterpSpeed. That pair has the closed form Target(t) = Target0 * e^-kt and
+	 * Recoil(t) = e^-kt * (Recoil0 + k * t * Target0), so any frame rate lands on the same curve.
+	 * Rotations are combined in log space, where the chase is linear like it is for location. The
+	 * target is kept in that space already, and has no scale, so only Recoil converts each update.
+	 */
+	inline void DecayRecoil(FTransform& Recoil, FVector& TargetLocation, FVector& TargetRotationLog, float DeltaSeconds, float InterpSpeed)
+	{
+		const float Decay = FMath::Exp(-InterpSpeed * DeltaSeconds);
+		const float Chase = InterpSpeed * DeltaSeconds * Decay;
+
+		Recoil.SetComponents(LogToQuat(QuatToLog(Recoil.GetRotation()) * Decay + TargetRotationLog * Chase),
+			Recoil.GetLocation() * Decay + TargetLocation * Chase,
+			FVector::OneVector + (Recoil.GetScale3D() - FVector::OneVector) * Decay);
+		TargetLocation *= Decay;
+		TargetRotationLog *= Decay;
+	}
+}
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTut/ADSTutImpactSubsystem.h"
+#include "ADSTut/ADSTutProjectile.h"
+#include "Misc/AutomationTest.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 NumProjectiles = 5000;
+	constexpr int32 PileSize = 8;
+	constexpr int32 NumFrames = 90;
+	constexpr float FrameSeconds = 1.0f / 60.0f;
+
+	AStaticMeshActor* SpawnCube(UWorld* World, UStaticMesh* CubeMesh, const FVector& Location, const FVector& Scale, bool bSimulatePhysics)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AStaticMeshActor* Cube = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, SpawnParams);
+
+		UStaticMeshComponent* MeshComponent = Cube->GetStaticMeshComponent();
+		MeshComponent->SetMobility(bSimulatePhysics ? EComponentMobility::Movable : EComponentMobility::Static);
+		MeshComponent->SetStaticMesh(CubeMesh);
+		MeshComponent->SetWorldScale3D(Scale);
+		if (bSimulatePhysics)
+		{
+			MeshComponent->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+			MeshComponent->SetSimulatePhysics(true);
+		}
+		return Cube;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutImpactStressTest, "ADSTut.Projectile.ImpactStress",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::StressFilter)
+
+/**
+ * Fires 5k projectiles into a pile of physics boxes in one frame and runs the world for a while.
+ * Every hit has to go through the impact stage exactly once, and the worst frame time is reported.
+ */
+bool FADSTutImpactStressTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh"), CubeMesh))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// The basic cube is 100 units across
+	SpawnCube(World, CubeMesh, FVector::ZeroVector, FVector(50.0f, 50.0f, 1.0f), false);
+	for (int32 X = 0; X < PileSize; ++X)
+	{
+		for (int32 Y = 0; Y < PileSize; ++Y)
+		{
+			for (int32 Z = 0; Z < PileSize / 2; ++Z)
+			{
+				SpawnCube(World, CubeMesh, FVector((X - PileSize / 2) * 110.0f, (Y - PileSize / 2) * 110.0f, 100.0f + Z * 110.0f), FVector::OneVector, true);
+			}
+		}
+	}
+
+	// A grid of projectiles straight down onto the pile, all at once for the worst burst of hits
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(float(NumProjectiles)));
+	const float GridSpacing = PileSize * 110.0f / GridSize;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		const FVector Location((Index % GridSize - GridSize / 2) * GridSpacing, (Index / GridSize - GridSize / 2) * GridSpacing, 1500.0f);
+		World->SpawnActor<AADSTutProjectile>(Location, FRotator(-90.0f, 0.0f, 0.0f), SpawnParams);
+	}
+
+	UADSTutImpactSubsystem* ImpactSubsystem = World->GetSubsystem<UADSTutImpactSubsystem>();
+	if (TestNotNull(TEXT("Impact subsystem"), ImpactSubsystem))
+	{
+		double MaxFrameSeconds = 0.0;
+		double TotalFrameSeconds = 0.0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, FrameSeconds);
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+			MaxFrameSeconds = FMath::Max(MaxFrameSeconds, Seconds);
+			TotalFrameSeconds += Seconds;
+
+			// The impact stage runs inside the world tick, nothing queued may outlive its frame
+			TestEqual(FString::Printf(TEXT("Impacts left after frame %d"), Frame), ImpactSubsystem->GetNumPendingImpacts(), 0);
+		}
+
+		TestTrue(TEXT("Projectiles hit the pile"), ImpactSubsystem->GetNumImpactsResolved() > 0);
+		// A projectile that kept its collision after queueing could hit again before the stage ran
+		TestEqual(TEXT("One impact per destroyed projectile"), ImpactSubsystem->GetNumImpactsResolved(), ImpactSubsystem->GetNumProjectilesDestroyed());
+
+		AddInfo(FString::Printf(TEXT("%lld impacts resolved, frame time max %.2fms, average %.2fms"),
+			ImpactSubsystem->GetNumImpactsResolved(), MaxFrameSeconds * 1000.0, TotalFrameSeconds * 1000.0 / NumFrames));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
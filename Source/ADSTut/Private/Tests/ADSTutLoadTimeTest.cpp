@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTut/ADSTutLoadout.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const TCHAR* LoadTimeTestMap = TEXT("/Game/FirstPersonCPP/Maps/FirstPersonExampleMap");
+
+	/** Waits for the first character to report a valid ADS pose, then records how long it took */
+	class FWaitForADSPoseCommand : public IAutomationLatentCommand
+	{
+	public:
+		FWaitForADSPoseCommand(FAutomationTestBase* InTest, float InTimeoutSeconds)
+			: Test(InTest)
+			, TimeoutSeconds(InTimeoutSeconds)
+		{
+		}
+
+		virtual bool Update() override
+		{
+			UWorld* World = AutomationCommon::GetAnyGameWorld();
+			const UADSTutLoadoutSubsystem* LoadoutSubsystem = World ? World->GetSubsystem<UADSTutLoadoutSubsystem>() : nullptr;
+			if (LoadoutSubsystem && LoadoutSubsystem->HasADSPoseReady())
+			{
+				const double Seconds = LoadoutSubsystem->GetADSPoseSecondsAfterMapLoad();
+				Test->AddInfo(FString::Printf(TEXT("First valid ADS pose %.3fs after map load"), Seconds));
+				Test->AddAnalyticsItem(FString::Printf(TEXT("ADSPoseSecondsAfterMapLoad=%.3f"), Seconds));
+				return true;
+			}
+
+			if (GetCurrentRunTime() > TimeoutSeconds)
+			{
+				Test->AddError(FString::Printf(TEXT("No valid ADS pose within %.0fs of loading %s"), TimeoutSeconds, LoadTimeTestMap));
+				return true;
+			}
+			return false;
+		}
+
+	private:
+		FAutomationTestBase* Test;
+		float TimeoutSeconds;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutLoadTimeTest, "ADSTut.Load.MapToADSPose",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Opens the example map and times it to the first valid ADS pose. Runs headless with
+ * -nullrhi -ExecCmds="Automation RunTests ADSTut.Load", the time is logged and reported as an analytics item.
+ */
+bool FADSTutLoadTimeTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(LoadTimeTestMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForADSPoseCommand(this, 30.0f));
+	return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTut/ADSTutRPCRateLimiter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutRPCRateLimiterTest, "ADSTut.Net.RPCRateLimiter",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FADSTutRPCRateLimiterTest::RunTest(const FString& Parameters)
+{
+	constexpr float Rate = 20.0f;
+	constexpr float Burst = 10.0f;
+
+	// A full bucket lets exactly a burst through at once
+	{
+		FRPCRateLimiter Limiter;
+		int32 Allowed = 0;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			Allowed += Limiter.TryConsume(1.0f, Rate, Burst) ? 1 : 0;
+		}
+		TestEqual(TEXT("Burst allowed at once"), Allowed, int32(Burst));
+		TestEqual(TEXT("Dropped since the burst"), int32(Limiter.DroppedCount), 100 - Allowed);
+
+		TestFalse(TEXT("Peek while empty"), Limiter.WouldAllow(1.0f, Rate, Burst));
+		TestTrue(TEXT("Wait for one token"), FMath::IsNearlyEqual(Limiter.GetSecondsUntilToken(Rate), 1.0f / Rate));
+		// Half a token of slack, the refill is float maths
+		const float RefilledTime = 1.0f + 1.5f / Rate;
+		TestTrue(TEXT("Peek once refilled"), Limiter.WouldAllow(RefilledTime, Rate, Burst));
+		TestTrue(TEXT("Consume once refilled"), Limiter.TryConsume(RefilledTime, Rate, Burst));
+		TestEqual(TEXT("Dropped count resets"), int32(Limiter.DroppedCount), 0);
+	}
+
+	// Peeking never changes the bucket, the Kick policy relies on that in _Validate
+	{
+		FRPCRateLimiter Limiter;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			Limiter.WouldAllow(0.0f, Rate, Burst);
+		}
+		int32 Allowed = 0;
+		while (Limiter.TryConsume(0.0f, Rate, Burst))
+		{
+			++Allowed;
+		}
+		TestEqual(TEXT("Burst after peeking"), Allowed, int32(Burst));
+	}
+
+	// A steady flood at 60 RPCs per frame over 10s is held to the refill rate plus one burst
+	{
+		FRPCRateLimiter Limiter;
+		int32 Allowed = 0;
+		for (int32 Frame = 0; Frame <= 600; ++Frame)
+		{
+			const float Now = Frame / 60.0f;
+			for (int32 Index = 0; Index < 60; ++Index)
+			{
+				Allowed += Limiter.TryConsume(Now, Rate, Burst) ? 1 : 0;
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Flood held to budget (%d allowed)"), Allowed), FMath::Abs(Allowed - int32(Burst + Rate * 10.0f)) <= 1);
+	}
+
+	// Long idle periods don't bank more than a burst
+	{
+		FRPCRateLimiter Limiter;
+		Limiter.TryConsume(0.0f, Rate, Burst);
+		int32 Allowed = 0;
+		while (Limiter.TryConsume(1000.0f, Rate, Burst))
+		{
+			++Allowed;
+		}
+		TestEqual(TEXT("Burst after idling"), Allowed, int32(Burst));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutRPCRateLimiterCostTest, "ADSTut.Net.RPCRateLimiterCost",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/** Cost per RPC, the limiter runs for every server RPC so it has to stay in the noise */
+bool FADSTutRPCRateLimiterCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCalls = 1000000;
+	FRPCRateLimiter Limiter;
+	int32 Allowed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		Allowed += Limiter.TryConsume(Index * 0.001f, 20.0f, 10.0f) ? 1 : 0;
+	}
+	const double NanosecondsPerCall = (FPlatformTime::Seconds() - StartTime) * 1e9 / NumCalls;
+
+	AddInfo(FString::Printf(TEXT("TryConsume: %.1f ns per call (%d allowed)"), NanosecondsPerCall, Allowed));
+	AddAnalyticsItem(FString::Printf(TEXT("RPCRateLimiterNsPerCall=%.1f"), NanosecondsPerCall));
+#if !UE_BUILD_DEBUG
+	TestTrue(TEXT("TryConsume under 50ns"), NanosecondsPerCall < 50.0);
+#endif
+	return true;
+}
+
+#endif
+	}
+
+	return true;
+}
+
+#endif
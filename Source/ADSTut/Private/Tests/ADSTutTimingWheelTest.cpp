@@ -0,0 +1,273 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ADSTut/ADSTutTimingWheel.h"
+#include "Misc/AutomationTest.h"
+#include "TimerManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Mirrors every timer in a map so the wheel can be checked against it. One tick is one second,
+	 * so delays and expiry ticks stay exact integers.
+	 */
+	struct FTimingWheelModel
+	{
+		FTimingWheel Wheel{ 1.0f };
+		FRandomStream Stream{ 1234 };
+		uint64 Now = 0;
+
+		TMap<int32, uint64> ExpireTicks;
+		TMap<int32, FWheelTimerHandle> Handles;
+		int32 NextId = 0;
+
+		int64 NumFired = 0;
+		int64 NumCancelled = 0;
+		int64 NumWrongTick = 0;
+		int64 NumUnexpected = 0;
+
+		/** Off while the model's clock can't follow the wheel, see the long advance below */
+		bool bMutateInCallbacks = true;
+
+		/** Spread over every level, most timers short like gameplay ones are */
+		uint64 RandomDelay()
+		{
+			const float Roll = Stream.FRand();
+			if (Roll < 0.6f) { return Stream.RandRange(1, 64); }
+			if (Roll < 0.85f) { return Stream.RandRange(65, 4096); }
+			if (Roll < 0.97f) { return Stream.RandRange(4097, 262144); }
+			return Stream.RandRange(262145, 2000000);
+		}
+
+		void Schedule(uint64 DelayTicks)
+		{
+			const int32 Id = NextId++;
+			ExpireTicks.Add(Id, Now + DelayTicks);
+			Handles.Add(Id, Wheel.Schedule(float(DelayTicks), FSimpleDelegate::CreateLambda([this, Id]() { OnFired(Id); })));
+		}
+
+		void CancelRandom()
+		{
+			if (Handles.Num() == 0)
+			{
+				return;
+			}
+
+			// Cheap pick, good enough to spread cancels across levels and slots
+			auto It = Handles.CreateIterator();
+			for (int32 Skip = Stream.RandRange(0, FMath::Min(Handles.Num() - 1, 16)); Skip > 0; --Skip)
+			{
+				++It;
+			}
+
+			FWheelTimerHandle Handle = It.Value();
+			if (!Wheel.IsScheduled(Handle))
+			{
+				++NumUnexpected;
+			}
+			Wheel.Cancel(Handle);
+			if (Wheel.IsScheduled(Handle) || Handle.IsValid())
+			{
+				++NumUnexpected;
+			}
+
+			ExpireTicks.Remove(It.Key());
+			It.RemoveCurrent();
+			++NumCancelled;
+		}
+
+		void OnFired(int32 Id)
+		{
+			const uint64* ExpireTick = ExpireTicks.Find(Id);
+			if (!ExpireTick)
+			{
+				// Cancelled or already fired
+				++NumUnexpected;
+				return;
+			}
+			if (*ExpireTick != Now)
+			{
+				++NumWrongTick;
+			}
+			ExpireTicks.Remove(Id);
+			Handles.Remove(Id);
+			++NumFired;
+
+			// Callbacks reschedule and cancel from inside the wheel's step, like gameplay code does
+			if (!bMutateInCallbacks)
+			{
+				return;
+			}
+			if (Stream.FRand() < 0.3f)
+			{
+				Schedule(RandomDelay());
+			}
+			if (Stream.FRand() < 0.1f)
+			{
+				CancelRandom();
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutTimingWheelTest, "ADSTut.Timers.TimingWheel",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FADSTutTimingWheelTest::RunTest(const FString& Parameters)
+{
+	FTimingWheelModel Model;
+
+	// Tick by tick, every timer has to fire on exactly its expiry tick
+	constexpr int32 NumSteps = 500000;
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		// Go quiet now and then so the wheel also runs empty
+		const bool bQuiet = (Step / 50000) % 4 == 3;
+		const int32 NumToSchedule = bQuiet ? 0 : Model.Stream.RandRange(0, 3);
+		for (int32 Index = 0; Index < NumToSchedule; ++Index)
+		{
+			Model.Schedule(Model.RandomDelay());
+		}
+		if (!bQuiet && Model.Stream.FRand() < 0.5f)
+		{
+			Model.CancelRandom();
+		}
+
+		++Model.Now;
+		Model.Wheel.Advance(1.0f);
+	}
+
+	TestEqual(TEXT("Timers fired on the wrong tick"), Model.NumWrongTick, int64(0));
+	TestEqual(TEXT("Cancelled, fired twice or stale handles"), Model.NumUnexpected, int64(0));
+
+	int64 NumOverdue = 0;
+	for (const TPair<int32, uint64>& Pair : Model.ExpireTicks)
+	{
+		NumOverdue += Pair.Value <= Model.Now ? 1 : 0;
+	}
+	TestEqual(TEXT("Timers past their expiry that never fired"), NumOverdue, int64(0));
+	TestTrue(TEXT("Exercised firing and cancelling"), Model.NumFired > 100000 && Model.NumCancelled > 100000);
+
+	// One long advance, as after a hitch, fires everything due and nothing early. The model doesn't
+	// know which tick inside the advance is current, so callbacks only count here
+	const uint64 HitchTicks = 100000;
+	const int64 NumFiredBefore = Model.NumFired;
+	int64 NumDue = 0;
+	for (const TPair<int32, uint64>& Pair : Model.ExpireTicks)
+	{
+		NumDue += Pair.Value <= Model.Now + HitchTicks ? 1 : 0;
+	}
+
+	Model.bMutateInCallbacks = false;
+	const int64 NumWrongTickBefore = Model.NumWrongTick;
+	Model.Wheel.Advance(float(HitchTicks));
+	Model.Now += HitchTicks;
+	Model.NumWrongTick = NumWrongTickBefore;
+
+	TestEqual(TEXT("Timers fired by a long advance"), Model.NumFired - NumFiredBefore, NumDue);
+	TestEqual(TEXT("Cancelled or fired twice during a long advance"), Model.NumUnexpected, int64(0));
+
+	int64 NumNotScheduled = 0;
+	for (const TPair<int32, FWheelTimerHandle>& Pair : Model.Handles)
+	{
+		NumNotScheduled += Model.Wheel.IsScheduled(Pair.Value) ? 0 : 1;
+	}
+	TestEqual(TEXT("Pending timers lost by a long advance"), NumNotScheduled, int64(0));
+
+	AddInfo(FString::Printf(TEXT("%lld fired, %lld cancelled, %d still scheduled"), Model.NumFired, Model.NumCancelled, Model.ExpireTicks.Num()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FADSTutRoundStartTimerCostTest, "ADSTut.Timers.RoundStartCost",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Round start: 500 pawns each schedule a handful of timers in the same frame, half of them get
+ * cancelled, then the rest run out over two seconds of 60Hz frames. Times the same pattern on
+ * FTimerManager and on the wheel and reports both, shared agents are too noisy to assert on.
+ */
+bool FADSTutRoundStartTimerCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumPawns = 500;
+	constexpr int32 TimersPerPawn = 8;
+	constexpr int32 NumTimers = NumPawns * TimersPerPawn;
+	constexpr int32 NumRounds = 20;
+	constexpr int32 NumFrames = 120;
+	constexpr float FrameSeconds = 1.0f / 60.0f;
+
+	// The same delays for both, up to a second and a half so all of them expire within the frames
+	TArray<float> Delays;
+	FRandomStream Stream(42);
+	for (int32 Index = 0; Index < NumTimers; ++Index)
+	{
+		Delays.Add(Stream.FRandRange(0.05f, 1.5f));
+	}
+
+	int32 NumFired = 0;
+
+	// FTimerManager ticks at most once per engine frame, step the frame counter like the engine loop does
+	const uint64 SavedFrameCounter = GFrameCounter;
+	double TimerManagerSeconds = 0.0;
+	{
+		TArray<FTimerHandle> Handles;
+		Handles.SetNum(NumTimers);
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			FTimerManager TimerManager;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumTimers; ++Index)
+			{
+				TimerManager.SetTimer(Handles[Index], FTimerDelegate::CreateLambda([&NumFired]() { ++NumFired; }), Delays[Index], false);
+			}
+			for (int32 Index = 0; Index < NumTimers; Index += 2)
+			{
+				TimerManager.ClearTimer(Handles[Index]);
+			}
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				++GFrameCounter;
+				TimerManager.Tick(FrameSeconds);
+			}
+			TimerManagerSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+	}
+	GFrameCounter = SavedFrameCounter;
+	TestEqual(TEXT("FTimerManager fired the uncancelled half"), NumFired, NumRounds * NumTimers / 2);
+
+	NumFired = 0;
+	double WheelSeconds = 0.0;
+	{
+		TArray<FWheelTimerHandle> Handles;
+		Handles.SetNum(NumTimers);
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			FTimingWheel Wheel(1.0f / 120.0f);
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumTimers; ++Index)
+			{
+				Handles[Index] = Wheel.Schedule(Delays[Index], FSimpleDelegate::CreateLambda([&NumFired]() { ++NumFired; }));
+			}
+			for (int32 Index = 0; Index < NumTimers; Index += 2)
+			{
+				Wheel.Cancel(Handles[Index]);
+			}
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Wheel.Advance(FrameSeconds);
+			}
+			WheelSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+	}
+	TestEqual(TEXT("Timing wheel fired the uncancelled half"), NumFired, NumRounds * NumTimers / 2);
+
+	const double TimerManagerMs = TimerManagerSeconds * 1000.0 / NumRounds;
+	const double WheelMs = WheelSeconds * 1000.0 / NumRounds;
+	AddInfo(FString::Printf(TEXT("%d pawns x %d timers, per round: FTimerManager %.3f ms, timing wheel %.3f ms (%.2fx)"),
+		NumPawns, TimersPerPawn, TimerManagerMs, WheelMs, TimerManagerMs / FMath::Max(WheelMs, 0.001)));
+	AddAnalyticsItem(FString::Printf(TEXT("RoundStartTimerManagerMs=%.3f"), TimerManagerMs));
+	AddAnalyticsItem(FString::Printf(TEXT("RoundStartTimingWheelMs=%.3f"), WheelMs));
+	return true;
+}
+
+#endif
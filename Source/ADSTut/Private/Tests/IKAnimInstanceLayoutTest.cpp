@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "IKAnimInstance.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIKAnimInstanceLayoutTest, "ADSTut.Animation.InstanceLayout",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Reports where the per update state of UIKAnimInstance sits and how many cache lines it spans, then
+ * times the character independent part of the update over a thousand instances. Timings are only
+ * reported, the layout checks are exact.
+ */
+bool FIKAnimInstanceLayoutTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 CacheLine = PLATFORM_CACHE_LINE_SIZE;
+
+	struct FMemberOffset
+	{
+		const TCHAR* Name;
+		SIZE_T Offset;
+		SIZE_T Size;
+	};
+	const FMemberOffset Members[] =
+	{
+		{ TEXT("Hot"), STRUCT_OFFSET(UIKAnimInstance, Hot), sizeof(FIKHotState) },
+		{ TEXT("RelativeHandTransform"), STRUCT_OFFSET(UIKAnimInstance, RelativeHandTransform), sizeof(FTransform) },
+		{ TEXT("SightTransform"), STRUCT_OFFSET(UIKAnimInstance, SightTransform), sizeof(FTransform) },
+		{ TEXT("LeftHandTransform"), STRUCT_OFFSET(UIKAnimInstance, LeftHandTransform), sizeof(FTransform) },
+		{ TEXT("TurningSwayTransform"), STRUCT_OFFSET(UIKAnimInstance, TurningSwayTransform), sizeof(FTransform) },
+		{ TEXT("RecoilTransform"), STRUCT_OFFSET(UIKAnimInstance, RecoilTransform), sizeof(FTransform) },
+		{ TEXT("SwayLocation"), STRUCT_OFFSET(UIKAnimInstance, SwayLocation), sizeof(FVector) },
+		{ TEXT("AimAlpha"), STRUCT_OFFSET(UIKAnimInstance, AimAlpha), sizeof(float) },
+		{ TEXT("ReloadAlpha"), STRUCT_OFFSET(UIKAnimInstance, ReloadAlpha), sizeof(float) },
+		{ TEXT("Character"), STRUCT_OFFSET(UIKAnimInstance, Character), sizeof(AADSTutCharacter*) },
+		{ TEXT("VectorCurve"), STRUCT_OFFSET(UIKAnimInstance, VectorCurve), sizeof(UCurveVector*) },
+		{ TEXT("FinalHandRotation"), STRUCT_OFFSET(UIKAnimInstance, FinalHandRotation), sizeof(FQuat) },
+		{ TEXT("FinalHandLocation"), STRUCT_OFFSET(UIKAnimInstance, FinalHandLocation), sizeof(FVector) },
+	};
+
+	AddInfo(FString::Printf(TEXT("sizeof(UIKAnimInstance) %d, sizeof(UAnimInstance) %d, sizeof(FIKHotState) %d"),
+		int32(sizeof(UIKAnimInstance)), int32(sizeof(UAnimInstance)), int32(sizeof(FIKHotState))));
+	for (const FMemberOffset& Member : Members)
+	{
+		AddInfo(FString::Printf(TEXT("  %-22s offset %4d size %3d lines %d-%d"), Member.Name, int32(Member.Offset), int32(Member.Size),
+			int32(Member.Offset / CacheLine), int32((Member.Offset + Member.Size - 1) / CacheLine)));
+	}
+
+	// Everything up to and including VectorCurve is read or written on every update
+	const SIZE_T HotBegin = STRUCT_OFFSET(UIKAnimInstance, Hot);
+	const SIZE_T HotEnd = STRUCT_OFFSET(UIKAnimInstance, VectorCurve) + sizeof(UCurveVector*);
+	const int32 HotLines = int32((HotEnd - 1) / CacheLine - HotBegin / CacheLine + 1);
+	AddInfo(FString::Printf(TEXT("Per update state: %d bytes over %d cache lines"), int32(HotEnd - HotBegin), HotLines));
+	AddAnalyticsItem(FString::Printf(TEXT("IKAnimInstanceSize=%d"), int32(sizeof(UIKAnimInstance))));
+	AddAnalyticsItem(FString::Printf(TEXT("IKAnimInstanceHotLines=%d"), HotLines));
+
+	TestEqual(TEXT("Hot state starts a cache line"), int32(HotBegin % CacheLine), 0);
+	TestEqual(TEXT("Per update state spans the minimum number of lines"), HotLines, int32((HotEnd - HotBegin + CacheLine - 1) / CacheLine));
+
+	// A thousand instances, firing and toggling aim on staggered frames like a full server of pawns would
+	constexpr int32 NumInstances = 1000;
+	constexpr int32 NumFrames = 600;
+	constexpr float DeltaSeconds = 1.0f / 60.0f;
+
+	TArray<UIKAnimInstance*> Instances;
+	for (int32 Index = 0; Index < NumInstances; ++Index)
+	{
+		Instances.Add(NewObject<UIKAnimInstance>(GetTransientPackage()));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (int32 Index = 0; Index < NumInstances; ++Index)
+		{
+			UIKAnimInstance* Instance = Instances[Index];
+			if ((Frame + Index) % 30 == 0)
+			{
+				Instance->Fire();
+			}
+			if ((Frame + Index) % 90 == 0)
+			{
+				Instance->SetAiming(!Instance->Hot.bIsAiming);
+			}
+			Instance->UpdateInterpolation(DeltaSeconds);
+		}
+	}
+	const double NanosecondsPerUpdate = (FPlatformTime::Seconds() - StartTime) * 1e9 / (double(NumInstances) * NumFrames);
+
+	AddInfo(FString::Printf(TEXT("%d instances: %.1f ns per instance update"), NumInstances, NanosecondsPerUpdate));
+	AddAnalyticsItem(FString::Printf(TEXT("IKAnimInstanceUpdateNs=%.1f"), NanosecondsPerUpdate));
+
+	for (UIKAnimInstance* Instance : Instances)
+	{
+		Instance->MarkPendingKill();
+	}
+	return true;
+}
+
+#endif
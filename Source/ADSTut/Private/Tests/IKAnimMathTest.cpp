@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ADSTut/Private/IKAnimMath.h"
+#include "Misc/AutomationTest.h"
+#include "Kismet/KismetMathLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Frame rates the animation has to look the same at, every sample time below is a whole number of frames at each */
+	const float TestFrameRates[] = { 30.0f, 60.0f, 144.0f, 240.0f };
+
+	struct FAnimSample
+	{
+		FTransform Recoil;
+		FRotator TurnSway;
+		FVector Sway;
+	};
+
+	/**
+	 * Replays the same input at FrameRate: a shot at 0s and another at 1/6s, turning at 900 deg/s
+	 * for the first half second then stopping, and the sway curve stepping to a new value at 1/3s.
+	 * Samples at 0.5s and 1s.
+	 */
+	void ReplayInput(float FrameRate, TArray<FAnimSample>& OutSamples)
+	{
+		const FTransform Shot(FRotator(3.0f, 0.5f, -2.0f), FVector(0.05f, -2.0f, 0.6f));
+		const float DeltaSeconds = 1.0f / FrameRate;
+		const int32 NumFrames = FMath::RoundToInt(FrameRate);
+
+		FTransform Recoil;
+		FVector FinalRecoilLocation = FVector::ZeroVector;
+		FVector FinalRecoilRotationLog = FVector::ZeroVector;
+		FRotator TurnSway = FRotator::ZeroRotator;
+		FVector Sway = FVector::ZeroVector;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			if (Frame == 0 || Frame == NumFrames / 6)
+			{
+				FinalRecoilRotationLog = IKAnimMath::QuatToLog(IKAnimMath::LogToQuat(FinalRecoilRotationLog) * Shot.GetRotation());
+				FinalRecoilLocation += Shot.GetLocation();
+			}
+
+			const FRotator FrameTurn = Frame < NumFrames / 2 ? FRotator(0.0f, 900.0f * DeltaSeconds, 0.0f) : FRotator::ZeroRotator;
+			const FVector SwayCurve = Frame < NumFrames / 3 ? FVector(1.0f, 0.0f, 0.5f) : FVector(-1.0f, 2.0f, 0.0f);
+
+			IKAnimMath::DecayRecoil(Recoil, FinalRecoilLocation, FinalRecoilRotationLog, DeltaSeconds, 10.0f);
+			TurnSway = IKAnimMath::ExpDecayTo(TurnSway, IKAnimMath::TurnSwayTarget(FrameTurn, DeltaSeconds), DeltaSeconds, 4.0f);
+			Sway = IKAnimMath::ExpDecayTo(Sway, SwayCurve, DeltaSeconds, 1.8f);
+
+			if (Frame + 1 == NumFrames / 2 || Frame + 1 == NumFrames)
+			{
+				OutSamples.Add({ Recoil, TurnSway, Sway });
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIKAnimFrameRateIndependenceTest, "ADSTut.Animation.FrameRateIndependence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIKAnimFrameRateIndependenceTest::RunTest(const FString& Parameters)
+{
+	// Every input change lands on a frame boundary at all four rates, so anything beyond float error
+	// would come from the filters themselves
+	constexpr float Tolerance = 1.e-3f;
+
+	TArray<FAnimSample> Reference;
+	ReplayInput(TestFrameRates[UE_ARRAY_COUNT(TestFrameRates) - 1], Reference);
+
+	// The recoil has to have moved, or matching would prove nothing
+	TestFalse(TEXT("Recoil moved"), Reference[0].Recoil.Equals(FTransform(), 0.01f));
+	TestTrue(TEXT("Recoil settles"), Reference[1].Recoil.Equals(FTransform(), 0.05f));
+
+	for (float FrameRate : TestFrameRates)
+	{
+		TArray<FAnimSample> Samples;
+		ReplayInput(FrameRate, Samples);
+		if (!TestEqual(TEXT("Sample count"), Samples.Num(), Reference.Num()))
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			const FAnimSample& Sample = Samples[Index];
+			const FAnimSample& Expected = Reference[Index];
+			const FString Context = FString::Printf(TEXT("%.0f FPS, sample %d"), FrameRate, Index);
+
+			TestTrue(FString::Printf(TEXT("Recoil location at %s"), *Context),
+				Sample.Recoil.GetLocation().Equals(Expected.Recoil.GetLocation(), Tolerance));
+			TestTrue(FString::Printf(TEXT("Recoil rotation at %s"), *Context),
+				FMath::RadiansToDegrees(Sample.Recoil.GetRotation().AngularDistance(Expected.Recoil.GetRotation())) < Tolerance);
+			TestTrue(FString::Printf(TEXT("Turn sway at %s"), *Context), Sample.TurnSway.Equals(Expected.TurnSway, Tolerance));
+			TestTrue(FString::Printf(TEXT("Sway at %s"), *Context), Sample.Sway.Equals(Expected.Sway, Tolerance));
+		}
+	}
+
+	// The closed form recoil is exact, a single step over a hitch lands where many small ones do
+	{
+		FTransform LongRecoil;
+		FVector LongFinalLocation(0.0f, -3.0f, 1.0f);
+		FVector LongFinalRotationLog = IKAnimMath::QuatToLog(FRotator(5.0f, 0.0f, -3.0f).Quaternion());
+		FTransform ShortRecoil = LongRecoil;
+		FVector ShortFinalLocation = LongFinalLocation;
+		FVector ShortFinalRotationLog = LongFinalRotationLog;
+
+		IKAnimMath::DecayRecoil(LongRecoil, LongFinalLocation, LongFinalRotationLog, 0.25f, 10.0f);
+		for (int32 Step = 0; Step < 60; ++Step)
+		{
+			IKAnimMath::DecayRecoil(ShortRecoil, ShortFinalLocation, ShortFinalRotationLog, 0.25f / 60.0f, 10.0f);
+		}
+		TestTrue(TEXT("Hitch frame recoil"), LongRecoil.Equals(ShortRecoil, 1.e-3f));
+		TestTrue(TEXT("Hitch frame recoil target"), LongFinalLocation.Equals(ShortFinalLocation, 1.e-3f)
+			&& LongFinalRotationLog.Equals(ShortFinalRotationLog, 1.e-3f));
+	}
+
+	// A flick at 240 FPS scales past 180 degrees, the sway must keep chasing it rather than wrap the other way
+	{
+		FRotator TurnSway = FRotator::ZeroRotator;
+		for (int32 Frame = 0; Frame < 240; ++Frame)
+		{
+			TurnSway = IKAnimMath::ExpDecayTo(TurnSway, IKAnimMath::TurnSwayTarget(FRotator(0.0f, 60.0f, 0.0f), 1.0f / 240.0f), 1.0f / 240.0f, 4.0f);
+		}
+		TestTrue(FString::Printf(TEXT("Fast turn sway keeps its direction (%.1f)"), TurnSway.Yaw), TurnSway.Yaw > 180.0f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIKAnimRecoilCostTest, "ADSTut.Animation.RecoilCost",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Times DecayRecoil against the pair of TInterpTo calls it replaced, as run for every pawn with
+ * recoil each frame. Reports both, frame times on a shared test agent are too noisy to assert on.
+ */
+bool FIKAnimRecoilCostTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumUpdates = 1000000;
+	constexpr float DeltaSeconds = 1.0f / 60.0f;
+	const FTransform Shot(FRotator(3.0f, 0.5f, -2.0f), FVector(0.05f, -2.0f, 0.6f));
+
+	// Re-fire every 30 updates so both paths keep doing real work rather than settling at identity
+	double InterpToSeconds = 0.0;
+	FVector InterpToChecksum = FVector::ZeroVector;
+	{
+		FTransform Recoil;
+		FTransform FinalRecoil;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Update = 0; Update < NumUpdates; ++Update)
+		{
+			if (Update % 30 == 0)
+			{
+				FinalRecoil = Shot;
+			}
+			Recoil = UKismetMathLibrary::TInterpTo(Recoil, FinalRecoil, DeltaSeconds, 10.0f);
+			FinalRecoil = UKismetMathLibrary::TInterpTo(FinalRecoil, FTransform(), DeltaSeconds, 10.0f);
+			InterpToChecksum += Recoil.GetLocation();
+		}
+		InterpToSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	double DecayRecoilSeconds = 0.0;
+	FVector DecayRecoilChecksum = FVector::ZeroVector;
+	{
+		FTransform Recoil;
+		FVector FinalRecoilLocation = FVector::ZeroVector;
+		FVector FinalRecoilRotationLog = FVector::ZeroVector;
+		const FVector ShotRotationLog = IKAnimMath::QuatToLog(Shot.GetRotation());
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Update = 0; Update < NumUpdates; ++Update)
+		{
+			if (Update % 30 == 0)
+			{
+				FinalRecoilLocation = Shot.GetLocation();
+				FinalRecoilRotationLog = ShotRotationLog;
+			}
+			IKAnimMath::DecayRecoil(Recoil, FinalRecoilLocation, FinalRecoilRotationLog, DeltaSeconds, 10.0f);
+			DecayRecoilChecksum += Recoil.GetLocation();
+		}
+		DecayRecoilSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	const double InterpToNs = InterpToSeconds * 1e9 / NumUpdates;
+	const double DecayRecoilNs = DecayRecoilSeconds * 1e9 / NumUpdates;
+	// The checksums keep the loops from being optimised away
+	AddInfo(FString::Printf(TEXT("Recoil update: TInterpTo pair %.1f ns, DecayRecoil %.1f ns (%.2fx) [%s %s]"),
+		InterpToNs, DecayRecoilNs, DecayRecoilNs / FMath::Max(InterpToNs, 0.001), *InterpToChecksum.ToString(), *DecayRecoilChecksum.ToString()));
+	AddAnalyticsItem(FString::Printf(TEXT("RecoilInterpToNs=%.1f"), InterpToNs));
+	AddAnalyticsItem(FString::Printf(TEXT("RecoilDecayRecoilNs=%.1f"), DecayRecoilNs));
+	return true;
+}
+
+#endif
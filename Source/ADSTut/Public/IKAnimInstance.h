@@ -10,6 +10,40 @@
 
 class AADSTutCharacter;
 class UCurveVector;
+
+/**
+ * UIKAnimInstance state that only C++ touches, read or written on every update. Packed into a single
+ * cache line: the recoil target keeps no scale and stores its rotation as the log space vector it
+ * decays in, the turn rotators stay FRotators, 12 bytes against 16 for a quaternion.
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FIKHotState
+{
+	FVector FinalRecoilLocation = FVector::ZeroVector;
+	FVector FinalRecoilRotationLog = FVector::ZeroVector;
+
+	FRotator UnmodifiedTurnRotator = FRotator::ZeroRotator;
+	FRotator OldRotation = FRotator::ZeroRotator;
+
+	/** Sway curve filtered over time, before the velocity scale */
+	FVector SwayCurveLocation = FVector::ZeroVector;
+
+	uint8 bInterpAiming : 1;
+	uint8 bIsAiming : 1;
+	uint8 bInterpRelativeHand : 1;
+	/** Set when the character's weapon became ready, the IK transforms are captured on the next update */
+	uint8 bPendingIKSetup : 1;
+
+	FIKHotState()
+		: bInterpAiming(false)
+		, bIsAiming(false)
+		, bInterpRelativeHand(false)
+		, bPendingIKSetup(false)
+	{
+	}
+};
+
+static_assert(sizeof(FIKHotState) == PLATFORM_CACHE_LINE_SIZE, "FIKHotState should fill exactly one cache line");
+
 UCLASS()
 class ADSTUT_API UIKAnimInstance : public UAnimInstance
 {
@@ -22,8 +56,13 @@ public:
 
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
-	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
-	AADSTutCharacter* Character;
+	// Everything up to FinalHandRotation is touched on every update, either here or by the AnimBP graph.
+	// The C++ only part starts the run on its own cache line. The AnimBP reads the rest through
+	// property access, so those stay UPROPERTY members at full precision. Transforms come first so
+	// their 16 byte alignment doesn't leave padding between the smaller members.
+	// ADSTut.Animation.InstanceLayout reports the offsets and times a thousand instances
+
+	FIKHotState Hot;
 
 	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
 	FTransform RelativeHandTransform;
@@ -32,7 +71,14 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
 	FTransform LeftHandTransform;
 
-	FTransform FinalHandTransform;
+	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
+	FTransform TurningSwayTransform;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
+	FTransform RecoilTransform;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
+	FVector SwayLocation;
 
 	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
 	float AimAlpha;
@@ -40,24 +86,17 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
 	float ReloadAlpha;
 
+	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
+	AADSTutCharacter* Character;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "TUTORIAL")
 	UCurveVector* VectorCurve;
 
-	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
-	FVector SwayLocation;
-
-	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
-	FTransform TurningSwayTransform;
-	FRotator UnmodifiedTurnRotator;
-	FRotator OldRotation;
+	// Written when the optic changes, then only read while the hand moves to it (Hot.bInterpRelativeHand).
+	// The optic and hand sockets carry no scale, so it's kept as rotation and translation
 
-	UPROPERTY(BlueprintReadOnly, Category = "TUTORIAL")
-	FTransform RecoilTransform;
-	FTransform FinalRecoilTransform;
-	
-	bool bInterpAiming;
-	bool bIsAiming;
-	bool bInterpRelativeHand;
+	FQuat FinalHandRotation;
+	FVector FinalHandLocation;
 
 protected:
 	void SetSightTransform();
@@ -65,16 +104,20 @@ protected:
 	void SetFinalHandTransform();
 	void SetLeftHandIK();
 
+	void OnWeaponReady();
+
 	void InterpAiming(float DeltaSeconds);
 	void InterpRelativeHand(float DeltaSeconds);
 
 	void MoveVectorCurve(float DeltaSeconds);
 	void RotateWithRotation(float DeltaSeconds);
 
-	void InterpFinalRecoil(float DeltaSeconds);
 	void InterpRecoil(float DeltaSeconds);
 
 public:
+	/** Aim, optic and recoil interpolation. Only depends on the instance's own state, not on the character */
+	void UpdateInterpolation(float DeltaSeconds);
+
 	void SetAiming(bool IsAiming);
 
 	void CycledOptic();